@@ -13,6 +13,7 @@
 #include "timer_driver_hal.h"
 #include "usart_driver_hal.h"
 #include "i2c_driver_hal.h"
+#include "mpu6050_driver_hal.h"
 
 //Definición de los handlers necesarios
 GPIO_Handler_t   blinkyPin       = {0};
@@ -38,6 +39,10 @@ GPIO_Handler_t  pinSDA      = {0};
 I2C_Handler_t   accelSensor = {0};
 uint8_t i2c_AuxBuffer    = 0;
 
+//Handler de la IMU (usa el bus de accelSensor)
+MPU6050_Handler_t  imuSensor  = {0};
+MPU6050_Sample_t   imuSample  = {0};
+
 /*Registros y valores relacionados con el MPU*/
 #define  ACCEL_ADDRESS       0b1101000  //0xD0 --> dirección del Accel con Logic_0
 #define  ACCEL_XOUT_H        59 //0x3B
@@ -116,41 +121,23 @@ int main(void)
 				usart2DataRecv = '\0';
 			}
 
-			else if(usart2DataRecv == 'x'){
-				sprintf(bufferMsg, "Axis X data (r)\n");
-				usart_writeMsg(&usart2commSerial, bufferMsg);
-
-				uint8_t AccelX_low  = i2c_ReadSingleRegister(&accelSensor, ACCEL_XOUT_L);
-				uint8_t AccelX_high = i2c_ReadSingleRegister(&accelSensor, ACCEL_XOUT_H);
-				int16_t AccelX = AccelX_high << 8 | AccelX_low;
-
-				sprintf(bufferMsg, "AccelX = %d \n", (int) AccelX);
+			else if((usart2DataRecv == 'x') || (usart2DataRecv == 'y') || (usart2DataRecv == 'z')){
+				sprintf(bufferMsg, "Axis %c data (r)\n", usart2DataRecv);
 				usart_writeMsg(&usart2commSerial, bufferMsg);
-				usart2DataRecv = '\0';
-			}
 
-			else if(usart2DataRecv == 'y'){
-				sprintf(bufferMsg, "Axis Y data (r)\n");
-				usart_writeMsg(&usart2commSerial, bufferMsg);
+				//Una sola ráfaga de 14 bytes trae los tres ejes, la temperatura y el giroscopio
+				mpu6050_ReadSample(&imuSensor, &imuSample);
 
-				uint8_t AccelY_low  = i2c_ReadSingleRegister(&accelSensor, ACCEL_YOUT_L);
-				uint8_t AccelY_high = i2c_ReadSingleRegister(&accelSensor, ACCEL_YOUT_H);
-				int16_t AccelY = AccelY_high << 8 | AccelY_low;
+				int32_t accelAxis = imuSample.accelX;
+				if(usart2DataRecv == 'y'){
+					accelAxis = imuSample.accelY;
+				}
+				else if(usart2DataRecv == 'z'){
+					accelAxis = imuSample.accelZ;
+				}
 
-				sprintf(bufferMsg, "AccelY = %d \n", (int) AccelY);
-				usart_writeMsg(&usart2commSerial, bufferMsg);
-				usart2DataRecv = '\0';
-			}
-
-			else if(usart2DataRecv == 'z'){
-				sprintf(bufferMsg, "Axis Z data (r)\n");
-				usart_writeMsg(&usart2commSerial, bufferMsg);
-
-				uint8_t AccelZ_low  = i2c_ReadSingleRegister(&accelSensor, ACCEL_ZOUT_L);
-				uint8_t AccelZ_high = i2c_ReadSingleRegister(&accelSensor, ACCEL_ZOUT_H);
-				int16_t AccelZ = AccelZ_high << 8 | AccelZ_low;
-
-				sprintf(bufferMsg, "AccelZ = %d \n", (int) AccelZ);
+				//Q16.16 (g) a mili-g
+				sprintf(bufferMsg, "Accel%c = %d mg \n", usart2DataRecv - 32, (int)((accelAxis * 1000) >> 16));
 				usart_writeMsg(&usart2commSerial, bufferMsg);
 				usart2DataRecv = '\0';
 			}
@@ -159,12 +146,16 @@ int main(void)
 				sprintf(bufferMsg, "All 3 Axis(r)\n");
 				usart_writeMsg(&usart2commSerial, bufferMsg);
 
-				uint8_t AccelData[6]  = {0};
-				i2c_ReadManyRegisters(&accelSensor, ACCEL_XOUT_H, AccelData, 6);
-				int16_t AccelX = AccelData[0] << 8 | AccelData[1];
-				int16_t AccelY = AccelData[2] << 8 | AccelData[3];
-				int16_t AccelZ = AccelData[4] << 8 | AccelData[5];
-				sprintf(bufferMsg, "Accel x, y, z -> %d; %d; %d \n", (int) AccelX,(int) AccelY,(int) AccelZ );
+				mpu6050_ReadSample(&imuSensor, &imuSample);
+				sprintf(bufferMsg, "Accel x, y, z -> %d; %d; %d mg \n",
+						(int)((imuSample.accelX * 1000) >> 16),
+						(int)((imuSample.accelY * 1000) >> 16),
+						(int)((imuSample.accelZ * 1000) >> 16));
+				usart_writeMsg(&usart2commSerial, bufferMsg);
+				sprintf(bufferMsg, "Gyro x, y, z -> %d; %d; %d mdps \n",
+						(int)(((int64_t)imuSample.gyroX * 1000) >> 16),
+						(int)(((int64_t)imuSample.gyroY * 1000) >> 16),
+						(int)(((int64_t)imuSample.gyroZ * 1000) >> 16));
 				usart_writeMsg(&usart2commSerial, bufferMsg);
 				usart2DataRecv = '\0';
 			}
@@ -275,6 +266,18 @@ void config_I2C(void){
 	accelSensor.slaveAddress   = ACCEL_ADDRESS;
 
 	i2c_Config(&accelSensor);
+	i2c_SetPins(&accelSensor, &pinSDA, &pinSCL);
+
+	/*Configuración de la IMU: 1 kHz, filtro de 44 Hz, +-2g y +-250 grados/s*/
+	imuSensor.pI2CHandler   = &accelSensor;
+	imuSensor.address       = ACCEL_ADDRESS;
+	imuSensor.sampleRateHz  = 1000;
+	imuSensor.dlpf          = MPU6050_DLPF_44HZ;
+	imuSensor.accelRange    = MPU6050_ACCEL_RANGE_2G;
+	imuSensor.gyroRange     = MPU6050_GYRO_RANGE_250DPS;
+	imuSensor.fifoEnable    = MPU6050_FIFO_DISABLE;
+
+	mpu6050_Config(&imuSensor);
 }
 
 
@@ -11,6 +11,8 @@
 
 #include <stdint.h>
 #include "stm32f4xx.h"
+#include "timer_driver_hal.h"
+#include "pwm_driver_hal.h"
 
 enum{
 	CHANNEL_0 = 0,
@@ -64,6 +66,38 @@ enum{
 	TRIGGER_EXT
 };
 
+/* Flanco de la señal de trigger externo que inicia la conversión (EXTEN) */
+enum{
+	TRIGGER_EDGE_RISING = 1,
+	TRIGGER_EDGE_FALLING,
+	TRIGGER_EDGE_BOTH
+};
+
+/* Fuentes de trigger externo de la secuencia regular (EXTSEL del ADC_CR2, 11.12.3 del manual) */
+enum{
+	ADC_EXTSEL_TIM1_CC1 = 0,
+	ADC_EXTSEL_TIM1_CC2,
+	ADC_EXTSEL_TIM1_CC3,
+	ADC_EXTSEL_TIM2_CC2,
+	ADC_EXTSEL_TIM2_CC3,
+	ADC_EXTSEL_TIM2_CC4,
+	ADC_EXTSEL_TIM2_TRGO,
+	ADC_EXTSEL_TIM3_CC1,
+	ADC_EXTSEL_TIM3_TRGO,
+	ADC_EXTSEL_TIM4_CC4,
+	ADC_EXTSEL_TIM5_CC1,
+	ADC_EXTSEL_TIM5_CC2,
+	ADC_EXTSEL_TIM5_CC3,
+	ADC_EXTSEL_EXTI11 = 15,
+	ADC_EXTSEL_NONE   = 0xFF      //El timer (o su canal) no puede disparar el ADC
+};
+
+/* Resultado de la configuración del trigger */
+enum{
+	ADC_TRIGGER_OK = 0,
+	ADC_TRIGGER_UNSUPPORTED       //El timer o el canal no está conectado al ADC
+};
+
 enum{
 	SAMPLING_PERIOD_3_CYCLES = 0b000,
 	SAMPLING_PERIOD_15_CYCLES = 0b001,
@@ -75,6 +109,15 @@ enum{
 	SAMPLING_PERIOD_480_CYCLES = 0b111,
 };
 
+/* Número máximo de canales en la secuencia regular (SQR1 - SQR3) */
+#define ADC_MAX_SEQUENCE_LENGTH   16
+
+/* Forma de repetir la secuencia en el modo scan */
+enum{
+	ADC_SCAN_SINGLE = 0,      //Una sola secuencia por cada adc_StartScan()
+	ADC_SCAN_CONTINUOUS       //La secuencia se repite hasta llamar adc_StopScan()
+};
+
 /*ADC Handler definition
  * This Handler is used to configure a single ADC channel
  * -Channels         -> configures inside the driver the correct GPIO pin as ADC channel
@@ -94,10 +137,147 @@ typedef struct
 	uint8_t     interrupState;        //Para configurar si se desea o no trabajar con la interrupción
 } ADC_Config_t;
 
+/* Función que se llama al terminar una conversión, pContext es el puntero entregado al registrarla */
+typedef void (*ADC_Callback_t)(void *pContext, uint16_t adcData);
+
+/* Función que se llama al terminar una secuencia completa del modo scan.
+ * pSamples es el arreglo del usuario, con una muestra por canal en el orden de la secuencia */
+typedef void (*ADC_ScanCallback_t)(void *pContext, uint16_t *pSamples, uint8_t numberOfSamples);
+
+/* Número máximo de canales del grupo inyectado (JSQR) */
+#define ADC_MAX_INJECTED_LENGTH   4
+
+/* Fuentes de trigger externo del grupo inyectado (JEXTSEL del ADC_CR2, 11.12.3 del manual) */
+enum{
+	ADC_JEXTSEL_TIM1_CC4 = 0,
+	ADC_JEXTSEL_TIM1_TRGO,
+	ADC_JEXTSEL_TIM2_CC1,
+	ADC_JEXTSEL_TIM2_TRGO,
+	ADC_JEXTSEL_TIM3_CC2,
+	ADC_JEXTSEL_TIM3_CC4,
+	ADC_JEXTSEL_TIM4_CC1,
+	ADC_JEXTSEL_TIM4_CC2,
+	ADC_JEXTSEL_TIM4_CC3,
+	ADC_JEXTSEL_TIM4_TRGO,
+	ADC_JEXTSEL_TIM5_CC4,
+	ADC_JEXTSEL_TIM5_TRGO,
+	ADC_JEXTSEL_EXTI15   = 15,
+	ADC_JEXTSEL_SOFTWARE = 0xFF   //Se inicia con adc_StartInjected()
+};
+
+/*
+ * Grupo inyectado: hasta 4 canales que interrumpen la secuencia regular en curso
+ * (la regular continúa al terminar). Los datos no pasan por el DR, por lo que el
+ * grupo convive con el modo scan y el streaming por DMA.
+ * El offset (JOFRx) se resta de cada dato, así que el resultado puede ser negativo.
+ */
+typedef struct
+{
+	uint8_t            numberOfChannels;                          //1 - 4
+	uint8_t            channel[ADC_MAX_INJECTED_LENGTH];          //Canales en el orden de conversión
+	uint8_t            samplingPeriod[ADC_MAX_INJECTED_LENGTH];   //SAMPLING_PERIOD_x de cada canal
+	uint16_t           offset[ADC_MAX_INJECTED_LENGTH];           //Valor que se resta de cada dato (12 bits)
+	uint8_t            triggerSource;                             //ADC_JEXTSEL_x
+	uint8_t            triggerEdge;                               //TRIGGER_EDGE_x (no aplica por software)
+	volatile int16_t   data[ADC_MAX_INJECTED_LENGTH];             //Datos de la última conversión del grupo
+} ADC_InjectedGroup_t;
+
+/* Función que se llama al terminar el grupo inyectado */
+typedef void (*ADC_InjectedCallback_t)(void *pContext, ADC_InjectedGroup_t *pGroup);
+
+/* Canales vigilados por el watchdog analógico (AWDSGL) */
+enum{
+	ADC_AWD_ALL_CHANNELS = 0,
+	ADC_AWD_SINGLE_CHANNEL
+};
+
+/*
+ * Watchdog analógico sobre las conversiones regulares: el hardware compara cada dato
+ * con la banda [lowThreshold, highThreshold] (12 bits, sin alinear) y solo interrumpe
+ * cuando la señal sale de ella.
+ */
+typedef struct
+{
+	uint8_t     channelMode;      //ADC_AWD_SINGLE_CHANNEL o ADC_AWD_ALL_CHANNELS
+	uint8_t     channel;          //Canal vigilado en el modo de un solo canal
+	uint16_t    lowThreshold;     //Umbral inferior (LTR)
+	uint16_t    highThreshold;    //Umbral superior (HTR)
+} ADC_WatchdogConfig_t;
+
+/* Función que se llama cuando una conversión sale de la banda del watchdog */
+typedef void (*ADC_WatchdogCallback_t)(void *pContext);
+
+/* Resultado de las lecturas de un canal (adc_ReadChannel / adc_GetResult) */
+enum{
+	ADC_READ_OK = 0,
+	ADC_READ_PENDING,         //La conversión todavía no termina
+	ADC_READ_OVERWRITTEN,     //Ya terminó una conversión posterior y el dato se perdió
+	ADC_READ_BUSY,            //El ADC está ocupado en modo scan o streaming (DMA)
+	ADC_READ_TIMEOUT          //El ADC no terminó la conversión a tiempo (¿ADC apagado?)
+};
+
+/* Tiempo máximo de una conversión simple (480 ciclos de muestreo con ADCCLK lento) */
+#ifndef ADC_TIMEOUT_US
+#define ADC_TIMEOUT_US    1000
+#endif
+
+/*
+ * Streaming continuo con doble buffer (ping-pong).
+ * El DMA llena pBuffer de forma circular: mientras escribe el bloque B la aplicación
+ * procesa el bloque A y viceversa. Las interrupciones de medio bloque (HT) y bloque
+ * completo (TC) del DMA publican el bloque que se acaba de llenar.
+ * La tasa máxima es ADCCLK / (muestreo + resolución): con ADCCLK = 36 MHz, 3 ciclos
+ * y 12 bits se alcanzan 2.4 MSPS; con el HSI (PCLK2 = 16 MHz, ADCCLK = 8 MHz) son 533 kSPS.
+ */
+typedef struct
+{
+	uint16_t             *pBuffer;          //Arreglo de 2 * blockLength muestras (bloque A y bloque B)
+	uint16_t             blockLength;       //Muestras por bloque, múltiplo del largo de la secuencia
+	uint16_t * volatile  pReadyBlock;       //Bloque listo para procesar (0 si no hay ninguno)
+	volatile uint8_t     blockPending;      //Hay un bloque publicado que la aplicación no ha liberado
+	volatile uint32_t    blocksCompleted;   //Bloques llenados por el DMA
+	volatile uint32_t    blockOverruns;     //El DMA volvió a un bloque que la aplicación no había liberado
+	volatile uint32_t    adcOverruns;       //El ADC perdió datos (bandera OVR) y se reinició el streaming
+} ADC_Stream_t;
+
+/* Función que se llama desde el ISR del DMA con cada bloque nuevo del streaming */
+typedef void (*ADC_StreamCallback_t)(void *pContext, ADC_Stream_t *pStream, uint16_t *pBlock);
+
+/* Redondeo del resultado del sobremuestreo */
+enum{
+	ADC_DITHER_OFF = 0,       //Redondeo al más cercano
+	ADC_DITHER_ON             //Redondeo aleatorio (sin sesgo al promediar resultados)
+};
+
+/* Máximo número de bits extra del sobremuestreo (4^4 = 256 muestras por resultado) */
+#define ADC_OVERSAMPLING_MAX_BITS   4
+
+/*
+ * Sobremuestreo: se suman 4^n conversiones de un canal y la suma se desplaza n bits,
+ * para obtener un resultado de (resolución del ADC + n) bits. Solo funciona si la señal
+ * tiene al menos 1 LSB de ruido; una señal perfectamente quieta no gana resolución.
+ * Las muestras llegan por el streaming con doble buffer y el resultado se calcula en
+ * el ISR del DMA, sin trabajo en el programa principal.
+ */
+typedef struct
+{
+	uint8_t              extraBits;      //n: bits que se ganan (1 - ADC_OVERSAMPLING_MAX_BITS)
+	uint8_t              dithering;      //ADC_DITHER_OFF o ADC_DITHER_ON
+	uint16_t             *pBuffer;       //Arreglo del usuario de 2 * 4^n muestras
+	uint8_t              resultBits;     //Bits del resultado (lo calcula el driver)
+	volatile uint16_t    result;         //Último resultado
+	volatile uint32_t    resultCount;    //Resultados calculados
+	ADC_Stream_t         stream;         //Streaming que llena el arreglo, con sus contadores de overrun
+} ADC_Oversampling_t;
+
+/* Función que se llama con cada resultado del sobremuestreo */
+typedef void (*ADC_OversamplingCallback_t)(void *pContext, uint16_t result);
+
 /* Headers definitions for the public functions of adc_driver_hal.c */
 void adc_ConfigSingleChannel(ADC_Config_t *adcConfig);
 void adc_ConfigAnalogPin(uint8_t adcChannel);
 void adc_CompleteCallback(void);
+void adc_RegisterCallback(ADC_Callback_t callback, void *pContext);
 void adc_StartSingleConv(void);
 void adc_ScanMode(uint8_t state);
 void adc_StartContinuousConv(void);
@@ -105,9 +285,40 @@ void adc_StopContinuousConv(void);
 void adc_peripheralOnOFF(uint8_t state);
 uint16_t adc_Get_Value(void);
 
+/* Lectura de un canal: bloqueante (adc_ReadChannel) o con número de secuencia
+ * (adc_StartReadChannel + adc_GetResult). Funcionan con o sin la interrupción EOC:
+ * sin ella, adc_GetResult() detecta el fin de conversión con la bandera EOC */
+uint8_t adc_ReadChannel(uint8_t channel, uint16_t *pData);
+uint32_t adc_StartReadChannel(uint8_t channel);
+uint8_t adc_GetResult(uint32_t sequence, uint16_t *pData);
+
 /* Configuraciones avanzadas del ADC */
-//void adc_ConfigMultiChannel(ADC_Config_t *adcConfig, uint8_t numeroDeCanales);
-//void adc_ConfigTrigger(uint8_t sourceType, PWM_Handler_t *triggerSignal);
+void adc_ConfigMultiChannel(ADC_Config_t *adcConfig, uint8_t numeroDeCanales);
+void adc_StartScan(uint16_t *pSamples, uint8_t scanMode);
+void adc_StopScan(void);
+void adc_ScanCompleteCallback(void);
+void adc_RegisterScanCallback(ADC_ScanCallback_t callback, void *pContext);
+void adc_StartStream(ADC_Stream_t *pStream);
+void adc_StopStream(void);
+uint16_t *adc_StreamGetBlock(ADC_Stream_t *pStream);
+void adc_StreamReleaseBlock(ADC_Stream_t *pStream);
+void adc_StreamBlockCallback(void);
+void adc_RegisterStreamCallback(ADC_StreamCallback_t callback, void *pContext);
+void adc_StartOversampling(ADC_Oversampling_t *pOversampling);
+void adc_StopOversampling(void);
+void adc_OversamplingCallback(void);
+void adc_RegisterOversamplingCallback(ADC_OversamplingCallback_t callback, void *pContext);
+uint8_t adc_ConfigTrigger(uint8_t sourceType, PWM_Handler_t *triggerSignal);
+uint8_t adc_ConfigTimerTrigger(Timer_Handler_t *pTimerHandler);
+void adc_ConfigInjected(ADC_InjectedGroup_t *pGroup);
+void adc_StartInjected(void);
+void adc_InjectedCallback(void);
+void adc_RegisterInjectedCallback(ADC_InjectedCallback_t callback, void *pContext);
+void adc_ConfigWatchdog(ADC_WatchdogConfig_t *pWatchdogConfig);
+void adc_SetWatchdogThresholds(uint16_t lowThreshold, uint16_t highThreshold);
+void adc_WatchdogOnOFF(uint8_t state);
+void adc_WatchdogCallback(void);
+void adc_RegisterWatchdogCallback(ADC_WatchdogCallback_t callback, void *pContext);
 
 
 #endif /* ADC_DRIVER_HAL_H_ */
@@ -0,0 +1,131 @@
+/*
+ * adxl345_driver_hal.h
+ *
+ *  Created on: 19/10/2026
+ *      Author: laurasofia
+ */
+
+#ifndef ADXL345_DRIVER_HAL_H_
+#define ADXL345_DRIVER_HAL_H_
+
+#include <stdint.h>
+#include "stm32f4xx.h"
+#include "i2c_driver_hal.h"
+#include "exti_driver_hal.h"
+
+/*
+ * Driver del acelerómetro ADXL345 (GY-291) sobre el driver I2C.
+ * El sensor guarda las muestras en su FIFO de 32 posiciones (modo stream) y levanta
+ * la interrupción WATERMARK cuando hay "watermark" muestras acumuladas. El pin INT1/INT2
+ * se conecta a una línea EXTI; el ISR solo levanta una bandera y el programa principal
+ * vacía la FIFO con adxl345_ReadFifo(). Así se pueden usar tasas de 100 Hz a 3200 Hz
+ * sin leer el sensor por cada muestra.
+ *
+ * La FIFO entrega una entrada por cada lectura de DATAX0 ... DATAZ1, por lo que cada
+ * entrada es una lectura de 6 bytes en una sola transacción (los tres ejes de la misma muestra).
+ */
+
+/* Dirección de 7 bits según el pin ALT ADDRESS (SDO) */
+#define ADXL345_ADDRESS_SDO_HIGH    0x1D
+#define ADXL345_ADDRESS_SDO_LOW     0x53
+
+/* Mapa de registros (datasheet, tabla 19) */
+#define ADXL345_REG_DEVID          0x00
+#define ADXL345_REG_BW_RATE        0x2C
+#define ADXL345_REG_POWER_CTL      0x2D
+#define ADXL345_REG_INT_ENABLE     0x2E
+#define ADXL345_REG_INT_MAP        0x2F
+#define ADXL345_REG_INT_SOURCE     0x30
+#define ADXL345_REG_DATA_FORMAT    0x31
+#define ADXL345_REG_DATAX0         0x32
+#define ADXL345_REG_FIFO_CTL       0x38
+#define ADXL345_REG_FIFO_STATUS    0x39
+
+/* Valor fijo del registro DEVID */
+#define ADXL345_DEVID              0xE5
+
+/* Bits de INT_ENABLE, INT_MAP e INT_SOURCE */
+#define ADXL345_INT_DATA_READY     (1 << 7)
+#define ADXL345_INT_WATERMARK      (1 << 1)
+#define ADXL345_INT_OVERRUN        (1 << 0)
+
+/* POWER_CTL */
+#define ADXL345_POWER_CTL_MEASURE  (1 << 3)
+
+/* DATA_FORMAT */
+#define ADXL345_DATA_FORMAT_FULL_RES    (1 << 3)
+
+/* FIFO_CTL: modo en los bits 7:6, muestras (watermark) en los bits 4:0 */
+#define ADXL345_FIFO_MODE_STREAM   (0b10 << 6)
+#define ADXL345_FIFO_SAMPLES_MASK  0x1F
+
+/* FIFO_STATUS: número de entradas en los bits 5:0 */
+#define ADXL345_FIFO_ENTRIES_MASK  0x3F
+
+/* Tamaño de la FIFO del sensor. Un buffer de este tamaño siempre alcanza para vaciarla */
+#define ADXL345_FIFO_SIZE          32
+
+/* Rango de medida (bits 1:0 de DATA_FORMAT) */
+enum
+{
+	ADXL345_RANGE_2G = 0,
+	ADXL345_RANGE_4G,
+	ADXL345_RANGE_8G,
+	ADXL345_RANGE_16G
+};
+
+/* Tasa de datos (código del registro BW_RATE, tabla 7 del datasheet) */
+enum
+{
+	ADXL345_RATE_100HZ  = 0x0A,
+	ADXL345_RATE_200HZ,
+	ADXL345_RATE_400HZ,
+	ADXL345_RATE_800HZ,
+	ADXL345_RATE_1600HZ,
+	ADXL345_RATE_3200HZ
+};
+
+/* Pin del sensor al que se envía la interrupción de watermark */
+enum
+{
+	ADXL345_INT_PIN_1 = 0,
+	ADXL345_INT_PIN_2
+};
+
+/* Resultado de las funciones del driver */
+enum
+{
+	ADXL345_OK = 0,
+	ADXL345_ERROR_BUS,        //Falló la transacción I2C (ver i2c_status del handler I2C)
+	ADXL345_ERROR_DEVID       //El dispositivo no respondió con el DEVID del ADXL345
+};
+
+/* Una muestra de los tres ejes, en cuentas del ADC del sensor */
+typedef struct
+{
+	int16_t    x;
+	int16_t    y;
+	int16_t    z;
+} ADXL345_Sample_t;
+
+typedef struct
+{
+	I2C_Handler_t      *pI2CHandler;     //Bus I2C, ya configurado con i2c_Config
+	uint8_t            address;          //ADXL345_ADDRESS_SDO_HIGH o _LOW
+	uint8_t            range;            //ADXL345_RANGE_xG
+	uint8_t            fullResolution;   //1: 4 mg/LSB en todos los rangos
+	uint8_t            dataRate;         //ADXL345_RATE_xHZ
+	uint8_t            watermark;        //Muestras acumuladas que lanzan la interrupción (1 - 31)
+	uint8_t            intPin;           //ADXL345_INT_PIN_1 o _2
+	volatile uint8_t   fifoReady;        //La levanta el ISR de la línea EXTI
+	uint32_t           overrunCount;     //Veces que la FIFO se llenó y se perdieron muestras
+} ADXL345_Handler_t;
+
+/* Prototipos de las funciones públicas */
+uint8_t adxl345_Config(ADXL345_Handler_t *pAdxlHandler);
+void adxl345_ConfigInterrupt(ADXL345_Handler_t *pAdxlHandler, EXTI_Config_t *pExtiConfig);
+uint8_t adxl345_FifoReady(ADXL345_Handler_t *pAdxlHandler);
+uint8_t adxl345_ReadFifo(ADXL345_Handler_t *pAdxlHandler, ADXL345_Sample_t *pSamples, uint8_t maxSamples);
+uint8_t adxl345_ReadSample(ADXL345_Handler_t *pAdxlHandler, ADXL345_Sample_t *pSample);
+
+#endif /* ADXL345_DRIVER_HAL_H_ */
@@ -0,0 +1,40 @@
+/*
+ * deadline_driver_hal.h
+ *
+ *  Created on: 19/10/2026
+ *      Author: laurasofia
+ */
+
+#ifndef DEADLINE_DRIVER_HAL_H_
+#define DEADLINE_DRIVER_HAL_H_
+
+#include <stdint.h>
+#include "stm32f4xx.h"
+
+/*
+ * Esperas con tiempo límite para los drivers bloqueantes.
+ * Se usa el contador de ciclos del DWT (CYCCNT), que cuenta a la frecuencia del HCLK
+ * sin necesitar interrupciones, por lo que funciona también dentro de un ISR o con
+ * las interrupciones globales desactivadas. La resta en 32 bits maneja el desborde
+ * del contador (hasta ~268 s a 16 MHz, ~44 s a 96 MHz).
+ *
+ * Uso típico:
+ *    Deadline_t deadline = deadline_Start(I2C_TIMEOUT_US);
+ *    while(!(I2Cx->SR1 & I2C_SR1_SB)){
+ *        if(deadline_Expired(&deadline)){ return eI2C_STATUS_TIMEOUT; }
+ *    }
+ */
+typedef struct
+{
+	uint32_t    startCycle;
+	uint32_t    timeoutCycles;
+} Deadline_t;
+
+/* Prototipos de las funciones públicas */
+Deadline_t deadline_Start(uint32_t timeoutUs);
+uint8_t deadline_Expired(Deadline_t *pDeadline);
+void deadline_DelayUs(uint32_t delayUs);
+uint32_t deadline_GetCycles(void);
+uint32_t deadline_CyclesToUs(uint32_t cycles);
+
+#endif /* DEADLINE_DRIVER_HAL_H_ */
@@ -0,0 +1,60 @@
+/*
+ * debounce_driver_hal.h
+ *
+ *  Created on: 19/10/2026
+ *      Author: laurasofia
+ */
+
+#ifndef DEBOUNCE_DRIVER_HAL_H_
+#define DEBOUNCE_DRIVER_HAL_H_
+
+#include <stdint.h>
+#include "stm32f4xx.h"
+
+/*
+ * Antirrebote por muestreo periódico.
+ * En lugar de una interrupción EXTI por cada flanco (y por cada rebote), un timer
+ * llama debounce_Sample() cada 2 - 10 ms. En cada llamada se lee el IDR completo de
+ * cada puerto registrado y los 16 pines se filtran en paralelo con un contador
+ * vertical de 2 bits: un pin cambia de estado solo después de 4 muestras iguales.
+ * El costo es fijo por tick, sin importar cuánto rebote el contacto.
+ */
+
+/* Número máximo de puertos que se pueden registrar */
+#define DEBOUNCE_MAX_PORTS        4
+
+/* Tamaño de la cola de eventos (debe ser potencia de 2) */
+#define DEBOUNCE_QUEUE_SIZE       16
+
+enum
+{
+	DEBOUNCE_EVENT_PRESS = 0,
+	DEBOUNCE_EVENT_RELEASE,
+	DEBOUNCE_EVENT_HOLD
+};
+
+/* Configuración de un puerto. Los pines deben estar configurados como entradas con gpio_Config */
+typedef struct
+{
+	GPIO_TypeDef   *pGPIOx;          //Puerto a muestrear
+	uint16_t       pinMask;          //Pines del puerto que se filtran
+	uint16_t       activeLowMask;    //Pines que se consideran "presionados" en 0 (pull-up, ej. PC13)
+} Debounce_PortConfig_t;
+
+/* Evento entregado a la aplicación */
+typedef struct
+{
+	uint8_t    portIndex;     //Índice retornado por debounce_AddPort
+	uint8_t    pinNumber;     //PIN_0 ... PIN_15
+	uint8_t    eventType;     //Press, release o hold
+} Debounce_Event_t;
+
+/* Prototipos de las funciones públicas */
+void debounce_Init(uint16_t holdTicks);
+uint8_t debounce_AddPort(Debounce_PortConfig_t *pPortConfig);
+void debounce_Sample(void);
+uint8_t debounce_GetEvent(Debounce_Event_t *pEvent);
+uint16_t debounce_GetState(uint8_t portIndex);
+uint16_t debounce_GetDroppedEvents(void);
+
+#endif /* DEBOUNCE_DRIVER_HAL_H_ */
@@ -0,0 +1,127 @@
+/*
+ * dma_driver_hal.h
+ *
+ *  Created on: 19/10/2026
+ *      Author: laurasofia
+ */
+
+#ifndef DMA_DRIVER_HAL_H_
+#define DMA_DRIVER_HAL_H_
+
+#include <stdint.h>
+#include "stm32f4xx.h"
+
+/* 9.5.5 DMA_SxCR - CHSEL (tres bits) */
+enum
+{
+	DMA_CHANNEL_0 = 0,
+	DMA_CHANNEL_1,
+	DMA_CHANNEL_2,
+	DMA_CHANNEL_3,
+	DMA_CHANNEL_4,
+	DMA_CHANNEL_5,
+	DMA_CHANNEL_6,
+	DMA_CHANNEL_7
+};
+
+/* 9.5.5 DMA_SxCR - DIR (dos bits) */
+enum
+{
+	DMA_DIR_PERIPH_TO_MEM = 0,
+	DMA_DIR_MEM_TO_PERIPH,
+	DMA_DIR_MEM_TO_MEM
+};
+
+/* 9.5.5 DMA_SxCR - PSIZE y MSIZE (dos bits cada uno) */
+enum
+{
+	DMA_DATASIZE_8BIT = 0,
+	DMA_DATASIZE_16BIT,
+	DMA_DATASIZE_32BIT
+};
+
+/* 9.5.5 DMA_SxCR - PL (dos bits) */
+enum
+{
+	DMA_PRIORITY_LOW = 0,
+	DMA_PRIORITY_MEDIUM,
+	DMA_PRIORITY_HIGH,
+	DMA_PRIORITY_VERY_HIGH
+};
+
+enum
+{
+	DMA_INCREMENT_DISABLE = 0,
+	DMA_INCREMENT_ENABLE
+};
+
+/* Modo normal, circular o doble buffer (DBM) */
+enum
+{
+	DMA_MODE_NORMAL = 0,
+	DMA_MODE_CIRCULAR,
+	DMA_MODE_DOUBLE_BUFFER
+};
+
+enum
+{
+	DMA_INT_DISABLE = 0,
+	DMA_INT_ENABLE
+};
+
+/* Banderas de cada stream, normalizadas a la posición del stream 0 (LISR/LIFCR) */
+#define DMA_FLAG_FEIF    (1U << 0)   //FIFO error
+#define DMA_FLAG_DMEIF   (1U << 2)   //Direct mode error
+#define DMA_FLAG_TEIF    (1U << 3)   //Transfer error
+#define DMA_FLAG_HTIF    (1U << 4)   //Half transfer
+#define DMA_FLAG_TCIF    (1U << 5)   //Transfer complete
+#define DMA_FLAG_ALL     (DMA_FLAG_FEIF | DMA_FLAG_DMEIF | DMA_FLAG_TEIF | DMA_FLAG_HTIF | DMA_FLAG_TCIF)
+
+/* Estructura con la configuración de un stream DMA */
+typedef struct
+{
+	uint8_t    channel;              //Canal (request) que se conecta al stream
+	uint8_t    direction;            //Periph -> Mem, Mem -> Periph o Mem -> Mem
+	uint8_t    periphDataSize;       //Tamaño del dato en el lado del periférico
+	uint8_t    memDataSize;          //Tamaño del dato en el lado de la memoria
+	uint8_t    periphIncrement;      //Se incrementa o no la dirección del periférico
+	uint8_t    memIncrement;         //Se incrementa o no la dirección de memoria
+	uint8_t    mode;                 //Normal, circular o doble buffer
+	uint8_t    priority;             //Prioridad del stream frente a los otros del mismo DMA
+	uint8_t    interruptHalf;        //Activa la interrupción de medio bloque (HTIE)
+	uint8_t    interruptComplete;    //Activa la interrupción de bloque completo (TCIE) y error (TEIE)
+} DMA_Config_t;
+
+/* Resultado de dma_StopTransfer */
+enum
+{
+	DMA_STATUS_OK = 0,
+	DMA_STATUS_TIMEOUT      //El stream no se detuvo a tiempo (EN sigue en 1)
+};
+
+/* Tiempo máximo para que el stream termine la transferencia en curso al apagarlo */
+#ifndef DMA_TIMEOUT_US
+#define DMA_TIMEOUT_US    1000
+#endif
+
+/*
+ * Handler de un stream DMA.
+ * El stream se selecciona directamente (DMA1_Stream0 ... DMA2_Stream7), pues la
+ * tabla de requests (tabla 27 y 28 del manual) fija el par stream/canal de cada periférico.
+ */
+typedef struct
+{
+	DMA_Stream_TypeDef   *pStream;
+	DMA_Config_t         config;
+} DMA_Handler_t;
+
+/* Prototipos de las funciones públicas */
+void dma_Config(DMA_Handler_t *pDMAHandler);
+void dma_StartTransfer(DMA_Handler_t *pDMAHandler, uint32_t periphAddress, uint32_t memAddress0, uint32_t memAddress1, uint16_t numberOfData);
+uint8_t dma_StopTransfer(DMA_Handler_t *pDMAHandler);
+uint16_t dma_GetRemaining(DMA_Handler_t *pDMAHandler);
+uint8_t dma_GetCurrentTarget(DMA_Handler_t *pDMAHandler);
+uint8_t dma_ReadFlags(DMA_Stream_TypeDef *pStream);
+void dma_ClearFlags(DMA_Stream_TypeDef *pStream, uint8_t flags);
+
+#endif /* DMA_DRIVER_HAL_H_ */
@@ -0,0 +1,132 @@
+/*
+ * dsp_driver_hal.h
+ *
+ *  Created on: 19/10/2026
+ *      Author: laurasofia
+ */
+
+#ifndef DSP_DRIVER_HAL_H_
+#define DSP_DRIVER_HAL_H_
+
+#include <stdint.h>
+
+/* Las pruebas en el PC (Test/dsp_driver_hal_test.c) compilan el módulo sin CMSIS */
+#ifndef DSP_HOST_TEST
+#include "stm32f4xx.h"
+#endif
+
+/*
+ * Filtros en punto fijo para las muestras del ADC y de los sensores.
+ * Los datos son Q15 (int16_t, 1.0 = 32768) o cualquier entero de 16 bits con signo,
+ * como el dato de 12 bits del ADC. Los acumuladores son de 32 bits (Q31) o de 64 bits
+ * donde la precisión lo requiere, y las salidas se saturan a 16 bits.
+ *
+ * En el Cortex-M4 (__ARM_FEATURE_DSP) se usan las instrucciones SIMD: SMLALD hace dos
+ * multiplicaciones de 16 bits y las acumula en 64 bits, PKHBT empaqueta dos datos de
+ * 16 bits y SSAT satura. En otro procesador se compila la versión en C.
+ *
+ * Cada filtro tiene su estructura de estado (una por señal), una función Init y una
+ * función que procesa una muestra.
+ */
+
+typedef int16_t q15_t;
+typedef int32_t q31_t;
+
+/* Convierte una constante en punto flotante a Q15 ([-1, 1)) o Q14 ([-2, 2)), para calcular coeficientes */
+#define DSP_FLOAT_TO_Q15(x)     ((q15_t)((x) * 32768.0f))
+#define DSP_FLOAT_TO_Q14(x)     ((q15_t)((x) * 16384.0f))
+
+/* Tamaño máximo de la ventana del filtro de mediana */
+#define DSP_MEDIAN_MAX_LENGTH   15
+
+/* Máximo orden del decimador CIC */
+#define DSP_CIC_MAX_ORDER       4
+
+/*
+ * Promedio móvil de 2^log2Length muestras con suma acumulada: por cada muestra se
+ * suma la nueva y se resta la que sale de la ventana, sin recorrer el arreglo ni dividir.
+ */
+typedef struct
+{
+	q15_t      *pHistory;       //Arreglo del usuario de 2^log2Length muestras
+	uint8_t    log2Length;      //Largo de la ventana como potencia de 2 (máximo 15)
+	uint16_t   index;           //Posición de la muestra más vieja
+	q31_t      sum;             //Suma de las muestras de la ventana
+} DSP_MovingAverage_t;
+
+/*
+ * Filtro exponencial (IIR de primer orden): y += alpha * (x - y).
+ * alpha en Q15: con alpha = 1/N el filtro se parece a un promedio de N muestras.
+ * El estado se guarda con 16 bits extra de fracción para que alpha pequeño no se trabe.
+ */
+typedef struct
+{
+	q15_t      alpha;           //Peso de la muestra nueva, en Q15 (0 - 32767)
+	int64_t    state;           //Salida con 16 bits de fracción
+} DSP_Exponential_t;
+
+/*
+ * Decimador CIC (integradores + peines) de orden N y factor 2^log2Decimation.
+ * Entrega una muestra por cada 2^log2Decimation de entrada; la ganancia R^N se
+ * compensa con un desplazamiento, por lo que order * log2Decimation debe ser <= 16.
+ * Los integradores desbordan a propósito (aritmética módulo 2^32).
+ */
+typedef struct
+{
+	uint8_t    order;                          //Número de etapas (1 - DSP_CIC_MAX_ORDER)
+	uint8_t    log2Decimation;                 //Factor de decimación como potencia de 2
+	uint32_t   counter;                        //Muestras de entrada desde la última salida (llega a 2^16)
+	uint32_t   integrator[DSP_CIC_MAX_ORDER];
+	uint32_t   comb[DSP_CIC_MAX_ORDER];         //Entrada anterior de cada peine
+} DSP_Cic_t;
+
+/*
+ * Mediana de las últimas "length" muestras (impar, máximo DSP_MEDIAN_MAX_LENGTH).
+ * Se mantiene una copia ordenada de la ventana: por cada muestra se retira la más
+ * vieja y se inserta la nueva, sin ordenar toda la ventana.
+ */
+typedef struct
+{
+	uint8_t    length;
+	uint8_t    index;                            //Posición de la muestra más vieja
+	q15_t      history[DSP_MEDIAN_MAX_LENGTH];   //Ventana en orden de llegada
+	q15_t      sorted[DSP_MEDIAN_MAX_LENGTH];    //Ventana ordenada de menor a mayor
+} DSP_Median_t;
+
+/*
+ * Biquad (IIR de segundo orden) en forma directa I:
+ * y[n] = b0*x[n] + b1*x[n-1] + b2*x[n-2] + a1*y[n-1] + a2*y[n-2]
+ * Coeficientes en Q14 (rango [-2, 2): 2.0 no se puede representar) y a1, a2 con el signo ya invertido respecto al
+ * denominador de la función de transferencia (misma convención de CMSIS-DSP).
+ */
+typedef struct
+{
+	q15_t      b0;
+	q15_t      b1;
+	q15_t      b2;
+	q15_t      a1;
+	q15_t      a2;
+	q15_t      x1;    //x[n-1]
+	q15_t      x2;    //x[n-2]
+	q15_t      y1;    //y[n-1]
+	q15_t      y2;    //y[n-2]
+} DSP_Biquad_t;
+
+/* Prototipos de las funciones públicas */
+void dsp_MovingAverageInit(DSP_MovingAverage_t *pFilter, q15_t *pHistory, uint8_t log2Length);
+q15_t dsp_MovingAverage(DSP_MovingAverage_t *pFilter, q15_t sample);
+
+void dsp_ExponentialInit(DSP_Exponential_t *pFilter, q15_t alpha, q15_t initialValue);
+q15_t dsp_Exponential(DSP_Exponential_t *pFilter, q15_t sample);
+
+void dsp_CicInit(DSP_Cic_t *pFilter, uint8_t order, uint8_t log2Decimation);
+uint8_t dsp_Cic(DSP_Cic_t *pFilter, q15_t sample, q15_t *pOutput);
+
+void dsp_MedianInit(DSP_Median_t *pFilter, uint8_t length, q15_t initialValue);
+q15_t dsp_Median(DSP_Median_t *pFilter, q15_t sample);
+
+void dsp_BiquadInit(DSP_Biquad_t *pFilter, q15_t b0, q15_t b1, q15_t b2, q15_t a1, q15_t a2);
+q15_t dsp_Biquad(DSP_Biquad_t *pFilter, q15_t sample);
+void dsp_BiquadBlock(DSP_Biquad_t *pFilter, const q15_t *pInput, q15_t *pOutput, uint16_t numberOfSamples);
+
+#endif /* DSP_DRIVER_HAL_H_ */
@@ -24,7 +24,13 @@ typedef struct
 	uint8_t			edgeType;		// Se selecciona si se desea un tipo de flanco subiendo o bajando
 }EXTI_Config_t;
 
+/* Función que se llama con cada flanco, pContext es el puntero entregado al registrarla */
+typedef void (*EXTI_Callback_t)(void *pContext);
+
 void exti_Config(EXTI_Config_t *extiConfig);
+void exti_RegisterCallback(EXTI_Config_t *extiConfig, EXTI_Callback_t callback, void *pContext);
+
+/* Si no se registra un callback, se llama la función de la línea correspondiente */
 void callback_ExtInt0(void);
 void callback_ExtInt1(void);
 void callback_ExtInt2(void);
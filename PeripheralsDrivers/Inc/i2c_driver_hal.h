@@ -21,34 +21,190 @@ enum{
 	eI2C_MODE_FM
 };
 
+/* Relación tLow/tHigh del SCL en modo Fast (bit DUTY del CCR) */
+enum{
+	eI2C_DUTY_2 = 0,     //tLow = 2 * tHigh
+	eI2C_DUTY_16_9       //tLow = 16/9 * tHigh, permite 400 kHz exactos con PCLK1 múltiplo de 10 MHz
+};
+
+/* Ya no es necesario indicar el reloj: el driver lo lee del RCC (se conservan por compatibilidad) */
 #define I2C_MAIN_CLOCK_4_MHz     4
 #define I2C_MAIN_CLOCK_16_MHz    16
 #define I2C_MAIN_CLOCK_20_MHz    20
 
-#define I2C_MODE_SM_SPEED    80  //100KHz clock signal
-#define I2C_MODE_FM_SPEED    13  //400KHz clock signal
+/* Velocidades por defecto de cada modo (si i2c_speedHz = 0) */
+#define I2C_SPEED_SM_HZ    100000
+#define I2C_SPEED_FM_HZ    400000
 
-#define I2C_MAX_RISE_TIME_SM   17
-#define I2C_MAX_RISE_TIME_FM   5
+/* Tiempo de subida máximo del estándar I2C, en ns */
+#define I2C_MAX_RISE_TIME_SM_NS   1000
+#define I2C_MAX_RISE_TIME_FM_NS   300
+
+/* Resultado de una transacción (bloqueante o no bloqueante) */
+enum{
+	eI2C_STATUS_OK = 0,
+	eI2C_STATUS_PENDING,      //En cola o en curso
+	eI2C_STATUS_NACK,         //El esclavo no respondió (AF)
+	eI2C_STATUS_ARB_LOST,     //Otro maestro tomó el bus (ARLO)
+	eI2C_STATUS_BUS_ERROR,    //START/STOP fuera de lugar (BERR) u overrun (OVR)
+	eI2C_STATUS_QUEUE_FULL,   //No se pudo encolar la transacción
+	eI2C_STATUS_TIMEOUT,      //Una bandera no llegó a tiempo (bus bloqueado), se recupera el bus
+	eI2C_STATUS_BUSY,         //Llamada bloqueante con transacciones no bloqueantes en curso
+	eI2C_STATUS_DMA_IN_USE    //El stream del DMA ya está asignado al otro periférico (I2C1_TX/I2C2_TX)
+};
+
+/*
+ * Clases de prioridad de la cola de transacciones no bloqueantes. Cuando el bus queda
+ * libre se atiende primero la clase más alta; dentro de una clase, en orden de llegada.
+ * Una transacción en curso nunca se interrumpe.
+ */
+enum{
+	eI2C_PRIORITY_PERIODIC = 0,   //Lecturas periódicas de sensores (muestreo)
+	eI2C_PRIORITY_NORMAL,         //Configuración y comandos de la aplicación
+	eI2C_PRIORITY_DIAGNOSTIC,     //Consultas de depuración (WHO_AM_I, volcado de registros...)
+	eI2C_PRIORITY_COUNT
+};
+
+/* Tiempo máximo de espera de cada bandera en las funciones bloqueantes (un byte a 100 kHz son 90 us) */
+#ifndef I2C_TIMEOUT_US
+#define I2C_TIMEOUT_US    5000
+#endif
+
+/* Medio periodo del SCL generado por GPIO durante la recuperación del bus (100 kHz) */
+#define I2C_RECOVERY_HALF_PERIOD_US    5
+
+/* Número de transacciones que se pueden encolar por periférico y por clase de prioridad */
+#define I2C_QUEUE_SIZE    8
+
+/* Con i2c_ConfigDma(), las transacciones con al menos estos bytes de datos usan el DMA */
+#define I2C_DMA_MIN_LENGTH    4
+
+/* Función que se llama al terminar una transacción, con su estado final */
+typedef void (*I2C_Callback_t)(void *pContext, uint8_t status);
+
+/* Estadísticas de latencia (desde que se encola hasta que termina) de un cliente */
+typedef struct
+{
+	uint32_t   completed;        //Transacciones terminadas (con o sin error)
+	uint32_t   errors;           //Transacciones terminadas con error
+	uint32_t   lastLatencyUs;
+	uint32_t   maxLatencyUs;
+	uint32_t   totalLatencyUs;   //Latencia promedio = totalLatencyUs / completed
+}I2C_ClientStats_t;
+
+/*
+ * Cliente del bus (un sensor, el intérprete de comandos...). Define la clase de prioridad
+ * de sus transacciones y acumula sus estadísticas. Debe existir mientras tenga transacciones.
+ */
+typedef struct
+{
+	uint8_t              priority;   //eI2C_PRIORITY_x
+	I2C_ClientStats_t    stats;
+}I2C_Client_t;
+
+/*
+ * Descriptor de una transacción no bloqueante (escritura o lectura de registros).
+ * El descriptor y el buffer pertenecen al llamador y deben existir hasta el callback.
+ */
+typedef struct
+{
+	uint8_t            slaveAddress;   //Dirección de 7 bits del esclavo
+	uint8_t            regAddress;     //Registro inicial
+	uint8_t            direction;      //eI2C_WRITE_DATA o eI2C_READ_DATA
+	uint8_t            *pData;         //Datos a escribir o buffer de lectura
+	uint8_t            length;         //Número de bytes de datos
+	I2C_Callback_t     callback;       //Puede ser 0
+	void               *pContext;
+	I2C_Client_t       *pClient;       //Puede ser 0: prioridad normal y sin estadísticas
+	volatile uint8_t   status;         //Estado de la transacción
+	uint32_t           submitCycle;    //Uso interno: instante en que se encoló
+}I2C_Transaction_t;
+
+/* Máximo de registros cacheables por dispositivo (uno por bit de validMask) */
+#define I2C_CACHE_MAX_REGS    32
+
+/*
+ * Copia en RAM (write-through) de los registros de configuración de un dispositivo.
+ * pRegMap declara los registros cacheables: los que solo cambian cuando el MCU los escribe
+ * (rangos, tasas, modos). Los que no están en el mapa se consideran volátiles (datos,
+ * estados, FIFO) y siempre se leen del bus.
+ * - Una escritura que no cambia el valor de un registro ya conocido no genera transacción.
+ * - Una lectura de registros cacheables ya conocidos se responde desde la RAM.
+ * Cualquier error del bus invalida la copia (el dispositivo pudo reiniciarse). Si se ejecuta
+ * un reset por software del dispositivo se debe llamar i2c_InvalidateCache().
+ * El caché pertenece a un dispositivo: usar un handler I2C por dispositivo.
+ */
+typedef struct
+{
+	const uint8_t   *pRegMap;        //Direcciones de los registros cacheables
+	uint8_t         regCount;        //Número de registros del mapa (máximo I2C_CACHE_MAX_REGS)
+	uint8_t         values[I2C_CACHE_MAX_REGS];
+	uint32_t        validMask;       //Bit n en 1: values[n] es igual al registro del dispositivo
+	uint32_t        elidedWrites;    //Escrituras que no fue necesario enviar
+	uint32_t        cachedReads;     //Lecturas respondidas desde la RAM
+}I2C_RegCache_t;
+
+/*
+ * Archivo de registros expuesto en modo esclavo.
+ * El maestro escribe un byte con la dirección del registro inicial y luego lee N bytes
+ * consecutivos a partir de ella (como un sensor I2C). Las lecturas se sirven directamente
+ * desde uno de los dos buffers (sin copias): la aplicación llena el otro y lo publica con
+ * i2c_SlavePublish(). Si el maestro está leyendo, el intercambio se aplica al terminar la
+ * transacción, así una lectura nunca mezcla datos de dos publicaciones.
+ */
+typedef struct
+{
+	uint8_t            ownAddress;     //Dirección de 7 bits del MCU en el bus
+	uint8_t            size;           //Número de registros (bytes) de cada buffer
+	uint8_t            *pBuffer[2];    //Dos buffers de size bytes, los entrega la aplicación
+	volatile uint8_t   frontIndex;     //Buffer que lee el maestro
+	volatile uint8_t   pendingSwap;    //Publicación esperando el final de una lectura
+	volatile uint8_t   busy;           //Hay una transacción en curso
+	uint8_t            regPointer;     //Último registro inicial escrito por el maestro
+	uint8_t            txPointer;
+	uint8_t            transmitting;
+	uint8_t            firstByte;
+	uint32_t           readCount;      //Lecturas atendidas
+}I2C_SlaveRegFile_t;
 
 typedef struct
 {
 	I2C_TypeDef   *pI2Cx;
 	uint8_t       slaveAddress;
 	uint8_t       i2c_mode;
-	uint8_t       i2c_mainClock;
+	uint8_t       i2c_mainClock;     //Lo escribe i2c_Config con el PCLK1 real, en MHz
 	uint8_t       i2c_data;
+	uint32_t      i2c_speedHz;       //Velocidad deseada del SCL (0 = la del modo)
+	uint8_t       i2c_duty;          //Solo en modo Fast
+	uint8_t       i2c_status;        //Resultado de la última transacción bloqueante
+	GPIO_Handler_t *pSdaPin;         //Pines para la recuperación del bus (ver i2c_SetPins)
+	GPIO_Handler_t *pSclPin;
+	I2C_RegCache_t *pRegCache;       //Caché de registros del dispositivo (puede ser 0)
 }I2C_Handler_t;
 
 /* Prototipos de las funciones púlicas */
 void i2c_Config(I2C_Handler_t *pHandlerI2C);
 uint8_t i2c_ReadSingleRegister(I2C_Handler_t *pHandlerI2C, uint8_t regToRead);
 uint8_t i2c_ReadManyRegisters(I2C_Handler_t *pHandlerI2C, uint8_t regToRead, uint8_t *bufferRxData, uint8_t numberOfBytes);
-void i2c_WriteSingleRegister(I2C_Handler_t *pHandlerI2C, uint8_t regToWrite, uint8_t newValue);
-void i2c_WriteManyRegisters(I2C_Handler_t *pHandlerI2C, uint8_t regToWrite, uint8_t *bufferRXData, uint8_t numberOfBytes);
+uint8_t i2c_WriteSingleRegister(I2C_Handler_t *pHandlerI2C, uint8_t regToWrite, uint8_t newValue);
+uint8_t i2c_WriteManyRegisters(I2C_Handler_t *pHandlerI2C, uint8_t regToWrite, uint8_t *bufferRXData, uint8_t numberOfBytes);
+void i2c_SetPins(I2C_Handler_t *pHandlerI2C, GPIO_Handler_t *setSdaPin, GPIO_Handler_t *setSclPin);
+void i2c_RecoverBus(I2C_Handler_t *pHandlerI2C);
+void i2c_AttachCache(I2C_Handler_t *pHandlerI2C, I2C_RegCache_t *pRegCache);
+void i2c_InvalidateCache(I2C_Handler_t *pHandlerI2C);
+
+/* Modo esclavo (el periférico deja de funcionar como maestro) */
+void i2c_ConfigSlave(I2C_Handler_t *pHandlerI2C, I2C_SlaveRegFile_t *pRegFile);
+uint8_t *i2c_SlaveGetWriteBuffer(I2C_SlaveRegFile_t *pRegFile);
+void i2c_SlavePublish(I2C_SlaveRegFile_t *pRegFile);
 
+/* Transacciones no bloqueantes (no mezclar con las funciones bloqueantes mientras haya transacciones en curso) */
+uint8_t i2c_SubmitTransaction(I2C_Handler_t *pHandlerI2C, I2C_Transaction_t *pTransaction);
+uint8_t i2c_SubmitBatch(I2C_Handler_t *pHandlerI2C, I2C_Transaction_t *pTransactions, uint8_t count);
+void i2c_ResetClientStats(I2C_Client_t *pClient);
+uint8_t i2c_IsIdle(I2C_Handler_t *pHandlerI2C);
+uint8_t i2c_ConfigDma(I2C_Handler_t *pHandlerI2C);
+uint32_t i2c_GetBusFrequency(I2C_Handler_t *pHandlerI2C);
 
-//void i2c_SetPins(GPIO_Handler_t *setSdaPin, GPIO_Handler_t *setSclPin);
-//void i2c_clearBusyFlagState(I2C_Handler_t *ptrHandlerI2C);
 
 #endif /* I2C_DRIVER_HAL_H_ */
@@ -0,0 +1,91 @@
+/*
+ * logic_analyzer_driver_hal.h
+ *
+ *  Created on: 19/10/2026
+ *      Author: laurasofia
+ */
+
+#ifndef LOGIC_ANALYZER_DRIVER_HAL_H_
+#define LOGIC_ANALYZER_DRIVER_HAL_H_
+
+#include <stdint.h>
+#include "stm32f4xx.h"
+#include "usart_driver_hal.h"
+
+/*
+ * Modo de captura "analizador lógico":
+ * El TIM1 genera un evento update cada (PSC * ARR) ciclos de reloj y cada evento
+ * pide al DMA2 (Stream5, canal 6 -> TIM1_UP) que copie el IDR completo del puerto
+ * seleccionado al buffer en RAM. La CPU no interviene mientras se captura.
+ *
+ * NOTA: El DMA2 es el único que puede leer el bus AHB1 (donde están los GPIO) como
+ * periférico, y de los timers del F411 solo el TIM1 pide su update al DMA2. Por esto
+ * el analizador ocupa el TIM1 y el Stream5 del DMA2.
+ *
+ * El disparo (trigger) se hace en hardware con el modo esclavo del TIM1, usando la
+ * entrada TI1 (PA8, AF1):
+ * - IMMEDIATE: comienza a capturar al llamar la_Arm().
+ * - RISING/FALLING_EDGE: el contador (y por tanto la captura) arranca con el flanco en PA8.
+ * - GATED_HIGH/LOW: se captura solo mientras PA8 está en el nivel indicado; la captura
+ *   se pausa y continúa sola con cada cambio de nivel.
+ * La captura se detiene al llenar el buffer o al llamar la_Stop().
+ */
+enum
+{
+	LA_TRIGGER_IMMEDIATE = 0,
+	LA_TRIGGER_RISING_EDGE,
+	LA_TRIGGER_FALLING_EDGE,
+	LA_TRIGGER_GATED_HIGH,
+	LA_TRIGGER_GATED_LOW
+};
+
+enum
+{
+	LA_STATE_IDLE = 0,
+	LA_STATE_ARMED,
+	LA_STATE_DONE
+};
+
+/*
+ * Formato del volcado por USART (little endian, binario):
+ * - Encabezado: 'L', 'A', máscara de canales (uint16), reloj del timer (uint32),
+ *   ciclos de reloj por muestra (uint32) y número de muestras (uint16).
+ * - Registros RLE: valor del puerto enmascarado (uint16) + número de muestras
+ *   consecutivas con ese valor (uint16, 1 - 65535).
+ * - Fin: un registro con valor 0 y longitud 0.
+ * Con esto la herramienta del PC reconstruye el tiempo de cada cambio para generar el VCD.
+ */
+#define LA_DUMP_SYNC_0         'L'
+#define LA_DUMP_SYNC_1         'A'
+
+/* Configuración de la captura */
+typedef struct
+{
+	GPIO_TypeDef   *pGPIOx;          //Puerto cuyo IDR se muestrea completo
+	uint16_t       channelMask;      //Pines del puerto que interesan (se aplica en el volcado RLE)
+	uint16_t       prescaler;        //Prescaler del TIM1
+	uint16_t       period;           //Periodo del TIM1, cada update es una muestra
+	uint8_t        triggerMode;      //Condición de inicio/parada de la captura
+	uint16_t       *pBuffer;         //Buffer de muestras (propiedad del llamador)
+	uint16_t       bufferSize;       //Número de muestras del buffer
+} LA_Config_t;
+
+/* Handler del analizador */
+typedef struct
+{
+	LA_Config_t      config;
+	volatile uint8_t state;             //Idle, esperando/capturando o terminado
+	uint16_t         samplesCaptured;   //Muestras válidas al terminar la captura
+} LA_Handler_t;
+
+/* Prototipos de las funciones públicas */
+void la_Config(LA_Handler_t *pLAHandler);
+void la_Arm(LA_Handler_t *pLAHandler);
+void la_Stop(LA_Handler_t *pLAHandler);
+uint8_t la_GetState(LA_Handler_t *pLAHandler);
+void la_DumpRLE(LA_Handler_t *pLAHandler, USART_Handler_t *ptrUsartHandler);
+
+/* Esta función puede ser sobre-escrita en el main para saber cuándo termina la captura */
+void la_CaptureCompleteCallback(void);
+
+#endif /* LOGIC_ANALYZER_DRIVER_HAL_H_ */
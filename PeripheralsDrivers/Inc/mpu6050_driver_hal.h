@@ -0,0 +1,148 @@
+/*
+ * mpu6050_driver_hal.h
+ *
+ *  Created on: 19/10/2026
+ *      Author: laurasofia
+ */
+
+#ifndef MPU6050_DRIVER_HAL_H_
+#define MPU6050_DRIVER_HAL_H_
+
+#include <stdint.h>
+#include "stm32f4xx.h"
+#include "i2c_driver_hal.h"
+
+/*
+ * Driver de la IMU MPU-6050 sobre el driver I2C.
+ * Los registros ACCEL_XOUT_H ... GYRO_ZOUT_L son consecutivos (0x3B - 0x48), así que una
+ * muestra completa (acelerómetro, temperatura y giroscopio) se lee con una sola ráfaga de
+ * 14 bytes. Con la FIFO activa, el sensor guarda esas mismas 14 bytes por muestra y el
+ * registro FIFO_R_W no incrementa la dirección, por lo que varias muestras salen en una
+ * misma transacción.
+ *
+ * Los valores se entregan en punto fijo Q16.16 (int32_t, 1.0 = 65536):
+ * aceleración en g, velocidad angular en grados/s y temperatura en grados Celsius.
+ */
+
+/* Dirección de 7 bits según el pin AD0 */
+#define MPU6050_ADDRESS_AD0_LOW     0x68
+#define MPU6050_ADDRESS_AD0_HIGH    0x69
+
+/* Mapa de registros (Register Map, rev 4.2) */
+#define MPU6050_REG_SMPLRT_DIV      0x19
+#define MPU6050_REG_CONFIG          0x1A
+#define MPU6050_REG_GYRO_CONFIG     0x1B
+#define MPU6050_REG_ACCEL_CONFIG    0x1C
+#define MPU6050_REG_FIFO_EN         0x23
+#define MPU6050_REG_INT_STATUS      0x3A
+#define MPU6050_REG_ACCEL_XOUT_H    0x3B
+#define MPU6050_REG_USER_CTRL       0x6A
+#define MPU6050_REG_PWR_MGMT_1      0x6B
+#define MPU6050_REG_FIFO_COUNTH     0x72
+#define MPU6050_REG_FIFO_R_W        0x74
+#define MPU6050_REG_WHO_AM_I        0x75
+
+/* Valor del registro WHO_AM_I */
+#define MPU6050_WHO_AM_I_VALUE      0x68
+
+/* FIFO_EN: sensores que se escriben en la FIFO */
+#define MPU6050_FIFO_EN_TEMP        (1 << 7)
+#define MPU6050_FIFO_EN_XG          (1 << 6)
+#define MPU6050_FIFO_EN_YG          (1 << 5)
+#define MPU6050_FIFO_EN_ZG          (1 << 4)
+#define MPU6050_FIFO_EN_ACCEL       (1 << 3)
+
+/* USER_CTRL */
+#define MPU6050_USER_CTRL_FIFO_EN     (1 << 6)
+#define MPU6050_USER_CTRL_FIFO_RESET  (1 << 2)
+
+/* PWR_MGMT_1: reloj del PLL con referencia al giroscopio X (recomendado por el fabricante) */
+#define MPU6050_PWR_MGMT_1_CLK_PLL_XG  0x01
+
+/* INT_STATUS */
+#define MPU6050_INT_FIFO_OFLOW      (1 << 4)
+
+/* Bytes por muestra: aceleración (6), temperatura (2) y giroscopio (6) */
+#define MPU6050_SAMPLE_SIZE         14
+
+/* Tamaño de la FIFO del sensor, en bytes */
+#define MPU6050_FIFO_SIZE           1024
+
+/* Muestras que se leen de la FIFO en una sola transacción (la longitud del I2C es de 8 bits) */
+#define MPU6050_FIFO_BURST_SAMPLES  (255 / MPU6050_SAMPLE_SIZE)
+
+/* Filtro pasa bajas digital (DLPF_CFG del registro CONFIG), ancho de banda del acelerómetro */
+enum
+{
+	MPU6050_DLPF_260HZ = 0,     //Sin filtro: el giroscopio muestrea a 8 kHz
+	MPU6050_DLPF_184HZ,
+	MPU6050_DLPF_94HZ,
+	MPU6050_DLPF_44HZ,
+	MPU6050_DLPF_21HZ,
+	MPU6050_DLPF_10HZ,
+	MPU6050_DLPF_5HZ
+};
+
+/* Rango del acelerómetro (AFS_SEL) */
+enum
+{
+	MPU6050_ACCEL_RANGE_2G = 0,
+	MPU6050_ACCEL_RANGE_4G,
+	MPU6050_ACCEL_RANGE_8G,
+	MPU6050_ACCEL_RANGE_16G
+};
+
+/* Rango del giroscopio (FS_SEL) */
+enum
+{
+	MPU6050_GYRO_RANGE_250DPS = 0,
+	MPU6050_GYRO_RANGE_500DPS,
+	MPU6050_GYRO_RANGE_1000DPS,
+	MPU6050_GYRO_RANGE_2000DPS
+};
+
+enum
+{
+	MPU6050_FIFO_DISABLE = 0,
+	MPU6050_FIFO_ENABLE
+};
+
+/* Resultado de las funciones del driver */
+enum
+{
+	MPU6050_OK = 0,
+	MPU6050_ERROR_BUS,          //Falló la transacción I2C (ver i2c_status del handler I2C)
+	MPU6050_ERROR_WHO_AM_I      //El dispositivo no respondió con el WHO_AM_I del MPU-6050
+};
+
+/* Una muestra, en punto fijo Q16.16 */
+typedef struct
+{
+	int32_t    accelX;     //g
+	int32_t    accelY;
+	int32_t    accelZ;
+	int32_t    temperature;  //Grados Celsius
+	int32_t    gyroX;      //Grados/s
+	int32_t    gyroY;
+	int32_t    gyroZ;
+} MPU6050_Sample_t;
+
+typedef struct
+{
+	I2C_Handler_t   *pI2CHandler;      //Bus I2C, ya configurado con i2c_Config
+	uint8_t         address;           //MPU6050_ADDRESS_AD0_LOW o _HIGH
+	uint16_t        sampleRateHz;      //Tasa de muestreo deseada (se ajusta al divisor más cercano)
+	uint8_t         dlpf;              //MPU6050_DLPF_xHZ
+	uint8_t         accelRange;        //MPU6050_ACCEL_RANGE_xG
+	uint8_t         gyroRange;         //MPU6050_GYRO_RANGE_xDPS
+	uint8_t         fifoEnable;        //MPU6050_FIFO_ENABLE: las muestras se acumulan en la FIFO
+	uint32_t        overflowCount;     //Veces que la FIFO se llenó y se tuvo que reiniciar
+} MPU6050_Handler_t;
+
+/* Prototipos de las funciones públicas */
+uint8_t mpu6050_Config(MPU6050_Handler_t *pMpuHandler);
+uint8_t mpu6050_ReadSample(MPU6050_Handler_t *pMpuHandler, MPU6050_Sample_t *pSample);
+uint8_t mpu6050_ReadFifo(MPU6050_Handler_t *pMpuHandler, MPU6050_Sample_t *pSamples, uint8_t maxSamples);
+uint8_t mpu6050_ResetFifo(MPU6050_Handler_t *pMpuHandler);
+
+#endif /* MPU6050_DRIVER_HAL_H_ */
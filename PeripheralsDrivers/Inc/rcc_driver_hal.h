@@ -0,0 +1,42 @@
+/*
+ * rcc_driver_hal.h
+ *
+ *  Created on: 19/10/2026
+ *      Author: laurasofia
+ */
+
+#ifndef RCC_DRIVER_HAL_H_
+#define RCC_DRIVER_HAL_H_
+
+#include <stdint.h>
+#include "stm32f4xx.h"
+
+/*
+ * Frecuencias de los relojes del sistema, calculadas a partir de los registros RCC_CFGR
+ * y RCC_PLLCFGR. Así los drivers que dependen de la frecuencia (I2C, USART, timers)
+ * siguen siendo correctos si la aplicación cambia el reloj (HSE, PLL, prescalers).
+ */
+
+/* Reloj interno HSI */
+#define RCC_HSI_VALUE    16000000UL
+
+/* Cristal/reloj externo HSE. En la Nucleo-F411RE llega del ST-LINK (MCO a 8 MHz) */
+#ifndef RCC_HSE_VALUE
+#define RCC_HSE_VALUE    8000000UL
+#endif
+
+/* Bus de un timer, para rcc_GetTimerClock */
+enum
+{
+	RCC_BUS_APB1 = 0,    //TIM2-5
+	RCC_BUS_APB2         //TIM1, TIM9-11
+};
+
+/* Prototipos de las funciones públicas */
+uint32_t rcc_GetSysclk(void);
+uint32_t rcc_GetHclk(void);
+uint32_t rcc_GetPclk1(void);
+uint32_t rcc_GetPclk2(void);
+uint32_t rcc_GetTimerClock(uint8_t bus);
+
+#endif /* RCC_DRIVER_HAL_H_ */
@@ -0,0 +1,105 @@
+/*
+ * scope_driver_hal.h
+ *
+ *  Created on: 19/10/2026
+ *      Author: laurasofia
+ */
+
+#ifndef SCOPE_DRIVER_HAL_H_
+#define SCOPE_DRIVER_HAL_H_
+
+#include <stdint.h>
+#include "stm32f4xx.h"
+#include "adc_driver_hal.h"
+#include "timer_driver_hal.h"
+#include "usart_driver_hal.h"
+
+/*
+ * Modo "osciloscopio": el ADC convierte con el TRGO del TIM2 o TIM3 y llena por DMA un
+ * doble buffer (streaming del driver ADC). Cada bloque terminado se empaqueta en su
+ * propio lugar a 8 o 12 bits y sale por el USART con el DMA de transmisión, directamente
+ * desde el buffer del ADC: la CPU solo empaqueta y arma el encabezado, no copia datos.
+ * Una trama son dos transferencias encadenadas en el ISR del DMA del USART:
+ * el encabezado y luego el bloque.
+ *
+ * Mientras sale un bloque el DMA del ADC llena el otro, por lo que cada trama debe salir
+ * en menos de un bloque: (SCOPE_HEADER_SIZE + bytes del bloque) * 10 / baudrate <
+ * blockLength / tasa de muestreo. A 921600 bps (92 kB/s) el límite es de ~61 kSPS con
+ * 12 bits y ~90 kSPS con 8 bits. Si un bloque se completa y la trama anterior no ha
+ * terminado, ese bloque se descarta y se cuenta en droppedBlocks; la trama que estaba
+ * saliendo queda dañada (el DMA del ADC ya la está sobrescribiendo) y el PC la
+ * reconoce por el checksum.
+ *
+ * NOTA: Con el HSI (16 MHz) el USART a 921600 bps tiene un error de 2.1 %. Para una
+ * transmisión confiable se recomienda subir el PCLK con el PLL (rcc_driver_hal).
+ */
+enum
+{
+	SCOPE_FORMAT_8BIT = 0,      //Los 8 bits más significativos, un byte por muestra
+	SCOPE_FORMAT_12BIT          //Dos muestras en tres bytes
+};
+
+enum
+{
+	SCOPE_STATE_IDLE = 0,
+	SCOPE_STATE_RUNNING
+};
+
+/* Resultado de scope_Start */
+enum
+{
+	SCOPE_OK = 0,
+	SCOPE_ERROR_CONFIG,         //Falta el buffer, o blockLength no sirve para el formato/secuencia
+	SCOPE_ERROR_TRIGGER         //El timer no puede disparar el ADC (solo TIM2 y TIM3)
+};
+
+/*
+ * Formato de cada trama (little endian, binario):
+ * - Encabezado (SCOPE_HEADER_SIZE bytes): 0xA5, 0x5A, bits por muestra (uint8: 8 ó 12),
+ *   canales de la secuencia (uint8), número del bloque (uint32), bloques descartados
+ *   hasta ahora (uint32), reloj del timer (uint32), ciclos del timer por disparo (uint32),
+ *   muestras del bloque (uint16), bytes del bloque (uint16) y checksum (uint16, suma de
+ *   los bytes del bloque).
+ * - Bloque a 8 bits: un byte por muestra.
+ * - Bloque a 12 bits: las muestras a y b van en b0 = a[7:0], b1 = a[11:8] | b[3:0] << 4,
+ *   b2 = b[11:4].
+ * Con varios canales las muestras van intercaladas en el orden de la secuencia del ADC.
+ * Un salto en el número del bloque indica bloques perdidos.
+ */
+#define SCOPE_SYNC_0           0xA5
+#define SCOPE_SYNC_1           0x5A
+#define SCOPE_HEADER_SIZE      26
+
+/* Configuración del osciloscopio */
+typedef struct
+{
+	USART_Handler_t   *pUsartHandler;   //USART ya configurado con usart_Config (TX)
+	Timer_Handler_t   *pTimerHandler;   //TIM2 o TIM3 ya configurado con timer_Config, fija la tasa de muestreo
+	uint8_t           format;           //SCOPE_FORMAT_8BIT o SCOPE_FORMAT_12BIT
+	uint16_t          *pBuffer;         //Arreglo del usuario de 2 * blockLength muestras
+	uint16_t          blockLength;      //Muestras por trama, múltiplo del largo de la secuencia (par a 12 bits)
+} Scope_Config_t;
+
+/* Handler del osciloscopio */
+typedef struct
+{
+	Scope_Config_t     config;
+	ADC_Stream_t       stream;                      //Streaming del ADC que llena pBuffer
+	uint8_t            header[SCOPE_HEADER_SIZE];   //Encabezado de la trama que está saliendo
+	uint8_t            *pPayload;                   //Bloque que sale después del encabezado
+	uint16_t           payloadBytes;
+	uint8_t            sampleShift;                 //Desplazamiento que lleva la muestra a 12 bits
+	uint8_t            channels;                    //Largo de la secuencia del ADC
+	uint32_t           timerClock;                  //Reloj del timer, para calcular la tasa en el PC
+	uint32_t           cyclesPerSample;             //(PSC + 1) * (ARR + 1)
+	volatile uint8_t   state;
+	volatile uint8_t   frameInProgress;             //Hay una trama saliendo por el USART
+	volatile uint32_t  framesSent;
+	volatile uint32_t  droppedBlocks;               //Bloques que no se enviaron (USART ocupado o error del DMA)
+} Scope_Handler_t;
+
+/* Prototipos de las funciones públicas */
+uint8_t scope_Start(Scope_Handler_t *pScopeHandler);
+void scope_Stop(Scope_Handler_t *pScopeHandler);
+
+#endif /* SCOPE_DRIVER_HAL_H_ */
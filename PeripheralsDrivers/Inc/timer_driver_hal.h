@@ -37,6 +37,9 @@ typedef struct
 	uint8_t     TIMx_InterruptEnable;   // Activa o desactiva el modo interrupción
 }Timer_BasicConfig_t;
 
+/* Función que se llama con cada update, pContext es el puntero entregado al registrarla */
+typedef void (*Timer_Callback_t)(void *pContext);
+
 /* Handler para el Timer */
 typedef struct
 {
@@ -57,8 +60,16 @@ typedef struct
 
 void timer_Config(Timer_Handler_t *pTimerHandler);
 void timer_SetState(Timer_Handler_t *pTimerHandler, uint8_t newState);
+void timer_RegisterCallback(Timer_Handler_t *pTimerHandler, Timer_Callback_t callback, void *pContext);
 
-/* Esta función debe ser sobre-escrita en el main para que el sistema funcione */
-void timer2_Callback(void);
+/* Si no se registra un callback, se llama la función del timer correspondiente,
+ * que debe ser sobre-escrita en el main para que el sistema funcione */
+void Timer2_Callback(void);
+void Timer3_Callback(void);
+void Timer4_Callback(void);
+void Timer5_Callback(void);
+void Timer9_Callback(void);
+void Timer10_Callback(void);
+void Timer11_Callback(void);
 
 #endif /* TIMER_DRIVER_HAL_H_ */
@@ -72,6 +72,15 @@ typedef struct
 	uint8_t	enableIntTX;
 }USART_Config_t;
 
+/* Función que se llama con cada dato recibido, pContext es el puntero entregado al registrarla */
+typedef void (*USART_Callback_t)(void *pContext, uint8_t rxData);
+
+/*
+ * Función que se llama (desde el ISR del DMA) cuando termina una transmisión por DMA.
+ * status es USART_DMA_OK, o USART_DMA_ERROR si el DMA se detuvo por un error (TEIF).
+ */
+typedef void (*USART_TxCallback_t)(void *pContext, uint8_t status);
+
 /*
  * Definicion del Handler para un USART:
  * - Estructura que contiene los SFR que controlan el periferico
@@ -93,13 +102,44 @@ typedef struct
 
 
 
+/* Tiempo máximo de espera de TXE por caracter (un caracter a 9600 bps son ~1 ms) */
+#ifndef USART_TIMEOUT_US
+#define USART_TIMEOUT_US    5000
+#endif
+
+/* Valor que retorna usart_WriteChar si el transmisor no se liberó a tiempo */
+#define USART_WRITE_TIMEOUT    (-1)
+
+/*
+ * Transmisión por DMA: el stream copia el arreglo al DR sin intervención de la CPU.
+ * Streams y canales (tabla 27 y 28 del manual): USART1_TX -> DMA2 Stream7 canal 4,
+ * USART2_TX -> DMA1 Stream6 canal 4, USART6_TX -> DMA2 Stream6 canal 5.
+ * Mientras haya una transmisión por DMA en curso no se debe usar usart_WriteChar().
+ */
+enum
+{
+	USART_DMA_OK = 0,
+	USART_DMA_BUSY,             //Todavía se está enviando el arreglo anterior
+	USART_DMA_UNSUPPORTED,      //El handler no corresponde al USART1, USART2 o USART6
+	USART_DMA_ERROR             //(Solo en el callback) el DMA se detuvo por un error de transferencia
+};
+
 /* Definicion de los prototipos para las funciones del USART */
 void usart_Config(USART_Handler_t *ptrUsartHandler);
 int  usart_WriteChar(USART_Handler_t *ptrUsartHandler, int dataToSend );
-void usart_writeMsg(USART_Handler_t *ptrUsartHandler, char *msgToSend );
+int  usart_writeMsg(USART_Handler_t *ptrUsartHandler, char *msgToSend );
 uint8_t usart_getRxData(void);
+void usart_RegisterRxCallback(USART_Handler_t *ptrUsartHandler, USART_Callback_t callback, void *pContext);
+uint8_t usart_WriteDma(USART_Handler_t *ptrUsartHandler, const uint8_t *pData, uint16_t length);
+uint8_t usart_TxDmaBusy(USART_Handler_t *ptrUsartHandler);
+void usart_RegisterTxCallback(USART_Handler_t *ptrUsartHandler, USART_TxCallback_t callback, void *pContext);
+
+/* Si no se registra un callback, se llama la función del USART correspondiente */
 void usart1_RxCallback(void);
 void usart2_RxCallback(void);
 void usart6_RxCallback(void);
 
+/* Si no se registra un callback de transmisión, se llama esta función */
+void usart_TxCompleteCallback(uint8_t status);
+
 #endif /* USART_DRIVER_HAL_H_ */
@@ -7,6 +7,8 @@
 
 #include "adc_driver_hal.h"
 #include "gpio_driver_hal.h"
+#include "dma_driver_hal.h"
+#include "deadline_driver_hal.h"
 #include "stm32f4xx.h"
 #include "stm32_assert.h"
 
@@ -17,11 +19,58 @@ static void adc_set_alignment(ADC_Config_t *adcConfig);
 static void adc_set_sampling_and_hold(ADC_Config_t *adcConfig);
 static void adc_set_one_channel_sequence(ADC_Config_t *adcConfig);
 static void adc_config_interrupt(ADC_Config_t *adcConfig);
+static void adc_set_channel_sampling(uint8_t channel, uint8_t samplingPeriod);
+static void adc_set_sequence_rank(uint8_t rank, uint8_t channel);
+static void adc_config_dma(uint8_t halfInterrupt);
+static void adc_start_dma_requests(uint16_t *pBuffer, uint16_t numberOfData, uint8_t scanMode);
+static void adc_start_stream(ADC_Stream_t *pStream, ADC_Oversampling_t *pOversampling);
+static void adc_stream_publish(uint16_t *pBlock);
+static void adc_oversampling_process(uint16_t *pBlock);
+static uint16_t adc_dither_next(void);
+static uint32_t adc_start_single_conversion(void);
+static uint8_t adc_get_cc_trigger_source(TIM_TypeDef *pTIMx, uint8_t pwmChannel);
+static void adc_set_external_trigger(uint8_t extSel, uint8_t edge);
+static void adc_set_timer_trgo_update(TIM_TypeDef *pTIMx);
 
 /* Variables y elementos que necesita internamente el driver para funcionar adecuadamente */
 GPIO_Handler_t handlerADCPin   = {0};
 uint16_t       adcRawData      = 0;
 
+/* Número de secuencia de la última conversión simple iniciada y de la última terminada */
+static volatile uint32_t adcSequenceStarted   = 0;
+static volatile uint32_t adcSequenceCompleted = 0;
+
+/* Callback registrado en tiempo de ejecución, con su contexto */
+static ADC_Callback_t adcCallback        = 0;
+static void           *adcCallbackContext = 0;
+
+/* Modo scan: el DMA2 Stream0 (canal 0) copia el DR en el arreglo del usuario */
+DMA_Handler_t             handlerADCDma          = {0};
+static uint16_t           *adcScanSamples        = 0;
+static uint8_t            adcScanLength          = 0;
+static ADC_ScanCallback_t adcScanCallback        = 0;
+static void               *adcScanCallbackContext = 0;
+
+/* Callback del watchdog analógico, con su contexto */
+static ADC_WatchdogCallback_t adcWatchdogCallback        = 0;
+static void                   *adcWatchdogCallbackContext = 0;
+
+/* Grupo inyectado configurado y su callback, con su contexto */
+static ADC_InjectedGroup_t    *ptrADCInjected             = 0;
+static ADC_InjectedCallback_t adcInjectedCallback        = 0;
+static void                   *adcInjectedCallbackContext = 0;
+
+/* Streaming con doble buffer, comparte el DMA2 Stream0 con el modo scan */
+static ADC_Stream_t         *ptrADCStream             = 0;
+static ADC_StreamCallback_t adcStreamCallback         = 0;
+static void                 *adcStreamCallbackContext = 0;
+
+/* Sobremuestreo: usa el streaming y procesa cada bloque en el ISR del DMA */
+static ADC_Oversampling_t         *ptrADCOversampling             = 0;
+static ADC_OversamplingCallback_t adcOversamplingCallback        = 0;
+static void                       *adcOversamplingCallbackContext = 0;
+static uint16_t                   adcDitherState                 = 0xACE1;
+
 /*
  *
  * */
@@ -156,757 +205,18 @@ static void adc_set_alignment(ADC_Config_t *adcConfig){
  * */
 static void adc_set_sampling_and_hold(ADC_Config_t *adcConfig){
 
-	switch(adcConfig->samplingPeriod){
-
-	case SAMPLING_PERIOD_3_CYCLES: {
-		if(adcConfig->channel == CHANNEL_0){
-			ADC1->SMPR2 &= ~ADC_SMPR2_SMP0_0;
-			ADC1->SMPR2 &= ~ADC_SMPR2_SMP0_1;
-			ADC1->SMPR2 &= ~ADC_SMPR2_SMP0_2;
-
-		}else if(adcConfig->channel == CHANNEL_1){
-			ADC1->SMPR2 &= ~ADC_SMPR2_SMP1_0;
-			ADC1->SMPR2 &= ~ADC_SMPR2_SMP1_1;
-			ADC1->SMPR2 &= ~ADC_SMPR2_SMP1_2;
-
-		}else if(adcConfig->channel == CHANNEL_2){
-			ADC1->SMPR2 &= ~ADC_SMPR2_SMP2_0;
-			ADC1->SMPR2 &= ~ADC_SMPR2_SMP2_1;
-			ADC1->SMPR2 &= ~ADC_SMPR2_SMP2_2;
-
-		}else if(adcConfig->channel == CHANNEL_3){
-			ADC1->SMPR2 &= ~ADC_SMPR2_SMP3_0;
-			ADC1->SMPR2 &= ~ADC_SMPR2_SMP3_1;
-			ADC1->SMPR2 &= ~ADC_SMPR2_SMP3_2;
-
-		}else if(adcConfig->channel == CHANNEL_4){
-			ADC1->SMPR2 &= ~ADC_SMPR2_SMP4_0;
-			ADC1->SMPR2 &= ~ADC_SMPR2_SMP4_1;
-			ADC1->SMPR2 &= ~ADC_SMPR2_SMP4_2;
-
-		}else if(adcConfig->channel == CHANNEL_5){
-			ADC1->SMPR2 &= ~ADC_SMPR2_SMP5_0;
-			ADC1->SMPR2 &= ~ADC_SMPR2_SMP5_1;
-			ADC1->SMPR2 &= ~ADC_SMPR2_SMP5_2;
-
-		}else if(adcConfig->channel == CHANNEL_6){
-			ADC1->SMPR2 &= ~ADC_SMPR2_SMP6_0;
-			ADC1->SMPR2 &= ~ADC_SMPR2_SMP6_1;
-			ADC1->SMPR2 &= ~ADC_SMPR2_SMP6_2;
-
-		}else if(adcConfig->channel == CHANNEL_7){
-			ADC1->SMPR2 &= ~ADC_SMPR2_SMP7_0;
-			ADC1->SMPR2 &= ~ADC_SMPR2_SMP7_1;
-			ADC1->SMPR2 &= ~ADC_SMPR2_SMP7_2;
-
-		}else if(adcConfig->channel == CHANNEL_8){
-			ADC1->SMPR2 &= ~ADC_SMPR2_SMP8_0;
-			ADC1->SMPR2 &= ~ADC_SMPR2_SMP8_1;
-			ADC1->SMPR2 &= ~ADC_SMPR2_SMP8_2;
-
-		}else if(adcConfig->channel == CHANNEL_9){
-			ADC1->SMPR2 &= ~ADC_SMPR2_SMP9_0;
-			ADC1->SMPR2 &= ~ADC_SMPR2_SMP9_1;
-			ADC1->SMPR2 &= ~ADC_SMPR2_SMP9_2;
-
-		}else if(adcConfig->channel == CHANNEL_10){
-			ADC1->SMPR1 &= ~ADC_SMPR1_SMP10_0;
-			ADC1->SMPR1 &= ~ADC_SMPR1_SMP10_1;
-			ADC1->SMPR1 &= ~ADC_SMPR1_SMP10_2;
-
-		}else if(adcConfig->channel == CHANNEL_11){
-			ADC1->SMPR1 &= ~ADC_SMPR1_SMP11_0;
-			ADC1->SMPR1 &= ~ADC_SMPR1_SMP11_1;
-			ADC1->SMPR1 &= ~ADC_SMPR1_SMP11_2;
-
-		}else if(adcConfig->channel == CHANNEL_12){
-			ADC1->SMPR1 &= ~ADC_SMPR1_SMP12_0;
-			ADC1->SMPR1 &= ~ADC_SMPR1_SMP12_1;
-			ADC1->SMPR1 &= ~ADC_SMPR1_SMP12_2;
-
-		}else if(adcConfig->channel == CHANNEL_13){
-			ADC1->SMPR1 &= ~ADC_SMPR1_SMP13_0;
-			ADC1->SMPR1 &= ~ADC_SMPR1_SMP13_1;
-			ADC1->SMPR1 &= ~ADC_SMPR1_SMP13_2;
-
-		}else if(adcConfig->channel == CHANNEL_14){
-			ADC1->SMPR1 &= ~ADC_SMPR1_SMP14_0;
-			ADC1->SMPR1 &= ~ADC_SMPR1_SMP14_1;
-			ADC1->SMPR1 &= ~ADC_SMPR1_SMP14_2;
-
-		}else if(adcConfig->channel == CHANNEL_15){
-			ADC1->SMPR1 &= ~ADC_SMPR1_SMP15_0;
-			ADC1->SMPR1 &= ~ADC_SMPR1_SMP15_1;
-			ADC1->SMPR1 &= ~ADC_SMPR1_SMP15_2;
-		}
-		break;
-	}
-	case SAMPLING_PERIOD_15_CYCLES: {
-		if(adcConfig->channel == CHANNEL_0){
-			ADC1->SMPR2 |= ADC_SMPR2_SMP0_0;
-			ADC1->SMPR2 &= ~ADC_SMPR2_SMP0_1;
-			ADC1->SMPR2 &= ~ADC_SMPR2_SMP0_2;
-
-		}else if(adcConfig->channel == CHANNEL_1){
-
-			ADC1->SMPR2 |= ADC_SMPR2_SMP1_0;
-			ADC1->SMPR2 &= ~ADC_SMPR2_SMP1_1;
-			ADC1->SMPR2 &= ~ADC_SMPR2_SMP1_2;
-
-		}else if(adcConfig->channel == CHANNEL_2){
-			ADC1->SMPR2 |= ADC_SMPR2_SMP2_0;
-			ADC1->SMPR2 &= ~ADC_SMPR2_SMP2_1;
-			ADC1->SMPR2 &= ~ADC_SMPR2_SMP2_2;
-
-		}else if(adcConfig->channel == CHANNEL_3){
-			ADC1->SMPR2 |= ADC_SMPR2_SMP3_0;
-			ADC1->SMPR2 &= ~ADC_SMPR2_SMP3_1;
-			ADC1->SMPR2 &= ~ADC_SMPR2_SMP3_2;
-
-		}else if(adcConfig->channel == CHANNEL_4){
-			ADC1->SMPR2 |= ADC_SMPR2_SMP4_0;
-			ADC1->SMPR2 &= ~ADC_SMPR2_SMP4_1;
-			ADC1->SMPR2 &= ~ADC_SMPR2_SMP4_2;
-
-		}else if(adcConfig->channel == CHANNEL_5){
-			ADC1->SMPR2 |= ADC_SMPR2_SMP5_0;
-			ADC1->SMPR2 &= ~ADC_SMPR2_SMP5_1;
-			ADC1->SMPR2 &= ~ADC_SMPR2_SMP5_2;
-
-		}else if(adcConfig->channel == CHANNEL_6){
-			ADC1->SMPR2 |= ADC_SMPR2_SMP6_0;
-			ADC1->SMPR2 &= ~ADC_SMPR2_SMP6_1;
-			ADC1->SMPR2 &= ~ADC_SMPR2_SMP6_2;
-
-		}else if(adcConfig->channel == CHANNEL_7){
-			ADC1->SMPR2 |= ADC_SMPR2_SMP7_0;
-			ADC1->SMPR2 &= ~ADC_SMPR2_SMP7_1;
-			ADC1->SMPR2 &= ~ADC_SMPR2_SMP7_2;
-
-		}else if(adcConfig->channel == CHANNEL_8){
-			ADC1->SMPR2 |= ADC_SMPR2_SMP8_0;
-			ADC1->SMPR2 &= ~ADC_SMPR2_SMP8_1;
-			ADC1->SMPR2 &= ~ADC_SMPR2_SMP8_2;
-
-		}else if(adcConfig->channel == CHANNEL_9){
-			ADC1->SMPR2 |= ADC_SMPR2_SMP9_0;
-			ADC1->SMPR2 &= ~ADC_SMPR2_SMP9_1;
-			ADC1->SMPR2 &= ~ADC_SMPR2_SMP9_2;
-
-		}else if(adcConfig->channel == CHANNEL_10){
-			ADC1->SMPR1 |= ADC_SMPR1_SMP10_0;
-			ADC1->SMPR1 &= ~ADC_SMPR1_SMP10_1;
-			ADC1->SMPR1 &= ~ADC_SMPR1_SMP10_2;
-
-		}else if(adcConfig->channel == CHANNEL_11){
-			ADC1->SMPR1 |= ADC_SMPR1_SMP11_0;
-			ADC1->SMPR1 &= ~ADC_SMPR1_SMP11_1;
-			ADC1->SMPR1 &= ~ADC_SMPR1_SMP11_2;
-
-		}else if(adcConfig->channel == CHANNEL_12){
-			ADC1->SMPR1 |= ADC_SMPR1_SMP12_0;
-			ADC1->SMPR1 &= ~ADC_SMPR1_SMP12_1;
-			ADC1->SMPR1 &= ~ADC_SMPR1_SMP12_2;
-
-		}else if(adcConfig->channel == CHANNEL_13){
-			ADC1->SMPR1 |= ADC_SMPR1_SMP13_0;
-			ADC1->SMPR1 &= ~ADC_SMPR1_SMP13_1;
-			ADC1->SMPR1 &= ~ADC_SMPR1_SMP13_2;
-
-		}else if(adcConfig->channel == CHANNEL_14){
-			ADC1->SMPR1 |= ADC_SMPR1_SMP14_0;
-			ADC1->SMPR1 &= ~ADC_SMPR1_SMP14_1;
-			ADC1->SMPR1 &= ~ADC_SMPR1_SMP14_2;
-
-		}else if(adcConfig->channel == CHANNEL_15){
-			ADC1->SMPR1 |= ADC_SMPR1_SMP15_0;
-			ADC1->SMPR1 &= ~ADC_SMPR1_SMP15_1;
-			ADC1->SMPR1 &= ~ADC_SMPR1_SMP15_2;
-		}
-		break;
-	}
-	case SAMPLING_PERIOD_28_CYCLES: {
-		if(adcConfig->channel == CHANNEL_0){
-			ADC1->SMPR2 &= ~ADC_SMPR2_SMP0_0;
-			ADC1->SMPR2 |= ADC_SMPR2_SMP0_1;
-			ADC1->SMPR2 &= ~ADC_SMPR2_SMP0_2;
-
-		}else if(adcConfig->channel == CHANNEL_1){
-			ADC1->SMPR2 &= ~ADC_SMPR2_SMP1_0;
-			ADC1->SMPR2 |= ADC_SMPR2_SMP1_1;
-			ADC1->SMPR2 &= ~ADC_SMPR2_SMP1_2;
-
-		}else if(adcConfig->channel == CHANNEL_2){
-			ADC1->SMPR2 &= ~ADC_SMPR2_SMP2_0;
-			ADC1->SMPR2 |= ADC_SMPR2_SMP2_1;
-			ADC1->SMPR2 &= ~ADC_SMPR2_SMP2_2;
-
-		}else if(adcConfig->channel == CHANNEL_3){
-			ADC1->SMPR2 &= ~ADC_SMPR2_SMP3_0;
-			ADC1->SMPR2 |= ADC_SMPR2_SMP3_1;
-			ADC1->SMPR2 &= ~ADC_SMPR2_SMP3_2;
-
-		}else if(adcConfig->channel == CHANNEL_4){
-			ADC1->SMPR2 &= ~ADC_SMPR2_SMP4_0;
-			ADC1->SMPR2 |= ADC_SMPR2_SMP4_1;
-			ADC1->SMPR2 &= ~ADC_SMPR2_SMP4_2;
-
-		}else if(adcConfig->channel == CHANNEL_5){
-			ADC1->SMPR2 &= ~ADC_SMPR2_SMP5_0;
-			ADC1->SMPR2 |= ADC_SMPR2_SMP5_1;
-			ADC1->SMPR2 &= ~ADC_SMPR2_SMP5_2;
-
-		}else if(adcConfig->channel == CHANNEL_6){
-			ADC1->SMPR2 &= ~ADC_SMPR2_SMP6_0;
-			ADC1->SMPR2 |= ADC_SMPR2_SMP6_1;
-			ADC1->SMPR2 &= ~ADC_SMPR2_SMP6_2;
-
-		}else if(adcConfig->channel == CHANNEL_7){
-			ADC1->SMPR2 &= ~ADC_SMPR2_SMP7_0;
-			ADC1->SMPR2 |= ADC_SMPR2_SMP7_1;
-			ADC1->SMPR2 &= ~ADC_SMPR2_SMP7_2;
-
-		}else if(adcConfig->channel == CHANNEL_8){
-			ADC1->SMPR2 &= ~ADC_SMPR2_SMP8_0;
-			ADC1->SMPR2 |= ADC_SMPR2_SMP8_1;
-			ADC1->SMPR2 &= ~ADC_SMPR2_SMP8_2;
-
-		}else if(adcConfig->channel == CHANNEL_9){
-			ADC1->SMPR2 &= ~ADC_SMPR2_SMP9_0;
-			ADC1->SMPR2 |= ADC_SMPR2_SMP9_1;
-			ADC1->SMPR2 &= ~ADC_SMPR2_SMP9_2;
-
-		}else if(adcConfig->channel == CHANNEL_10){
-			ADC1->SMPR1 &= ~ADC_SMPR1_SMP10_0;
-			ADC1->SMPR1 |= ADC_SMPR1_SMP10_1;
-			ADC1->SMPR1 &= ~ADC_SMPR1_SMP10_2;
-
-		}else if(adcConfig->channel == CHANNEL_11){
-			ADC1->SMPR1 &= ~ADC_SMPR1_SMP11_0;
-			ADC1->SMPR1 |= ADC_SMPR1_SMP11_1;
-			ADC1->SMPR1 &= ~ADC_SMPR1_SMP11_2;
-
-		}else if(adcConfig->channel == CHANNEL_12){
-			ADC1->SMPR1 &= ~ADC_SMPR1_SMP12_0;
-			ADC1->SMPR1 |= ADC_SMPR1_SMP12_1;
-			ADC1->SMPR1 &= ~ADC_SMPR1_SMP12_2;
-
-		}else if(adcConfig->channel == CHANNEL_13){
-			ADC1->SMPR1 &= ~ADC_SMPR1_SMP13_0;
-			ADC1->SMPR1 |= ADC_SMPR1_SMP13_1;
-			ADC1->SMPR1 &= ~ADC_SMPR1_SMP13_2;
-
-		}else if(adcConfig->channel == CHANNEL_14){
-			ADC1->SMPR1 &= ~ADC_SMPR1_SMP14_0;
-			ADC1->SMPR1 |= ADC_SMPR1_SMP14_1;
-			ADC1->SMPR1 &= ~ADC_SMPR1_SMP14_2;
-
-		}else if(adcConfig->channel == CHANNEL_15){
-			ADC1->SMPR1 &= ~ADC_SMPR1_SMP15_0;
-			ADC1->SMPR1 |= ADC_SMPR1_SMP15_1;
-			ADC1->SMPR1 &= ~ADC_SMPR1_SMP15_2;
-		}
-		break;
-	}
-	case SAMPLING_PERIOD_56_CYCLES: {
-		if(adcConfig->channel == CHANNEL_0){
-			ADC1->SMPR2 |= ADC_SMPR2_SMP0_0;
-			ADC1->SMPR2 |= ADC_SMPR2_SMP0_1;
-			ADC1->SMPR2 &= ~ADC_SMPR2_SMP0_2;
-
-		}else if(adcConfig->channel == CHANNEL_1){
-			ADC1->SMPR2 |= ADC_SMPR2_SMP1_0;
-			ADC1->SMPR2 |= ADC_SMPR2_SMP1_1;
-			ADC1->SMPR2 &= ~ADC_SMPR2_SMP1_2;
-
-		}else if(adcConfig->channel == CHANNEL_2){
-			ADC1->SMPR2 |= ADC_SMPR2_SMP2_0;
-			ADC1->SMPR2 |= ADC_SMPR2_SMP2_1;
-			ADC1->SMPR2 &= ~ADC_SMPR2_SMP2_2;
-
-		}else if(adcConfig->channel == CHANNEL_3){
-			ADC1->SMPR2 |= ADC_SMPR2_SMP3_0;
-			ADC1->SMPR2 |= ADC_SMPR2_SMP3_1;
-			ADC1->SMPR2 &= ~ADC_SMPR2_SMP3_2;
-
-		}else if(adcConfig->channel == CHANNEL_4){
-			ADC1->SMPR2 |= ADC_SMPR2_SMP4_0;
-			ADC1->SMPR2 |= ADC_SMPR2_SMP4_1;
-			ADC1->SMPR2 &= ~ADC_SMPR2_SMP4_2;
-
-		}else if(adcConfig->channel == CHANNEL_5){
-			ADC1->SMPR2 |= ADC_SMPR2_SMP5_0;
-			ADC1->SMPR2 |= ADC_SMPR2_SMP5_1;
-			ADC1->SMPR2 &= ~ADC_SMPR2_SMP5_2;
-
-		}else if(adcConfig->channel == CHANNEL_6){
-			ADC1->SMPR2 |= ADC_SMPR2_SMP6_0;
-			ADC1->SMPR2 |= ADC_SMPR2_SMP6_1;
-			ADC1->SMPR2 &= ~ADC_SMPR2_SMP6_2;
-
-		}else if(adcConfig->channel == CHANNEL_7){
-			ADC1->SMPR2 |= ADC_SMPR2_SMP7_0;
-			ADC1->SMPR2 |= ADC_SMPR2_SMP7_1;
-			ADC1->SMPR2 &= ~ADC_SMPR2_SMP7_2;
-
-		}else if(adcConfig->channel == CHANNEL_8){
-			ADC1->SMPR2 |= ADC_SMPR2_SMP8_0;
-			ADC1->SMPR2 |= ADC_SMPR2_SMP8_1;
-			ADC1->SMPR2 &= ~ADC_SMPR2_SMP8_2;
-
-		}else if(adcConfig->channel == CHANNEL_9){
-			ADC1->SMPR2 |= ADC_SMPR2_SMP9_0;
-			ADC1->SMPR2 |= ADC_SMPR2_SMP9_1;
-			ADC1->SMPR2 &= ~ADC_SMPR2_SMP9_2;
-
-		}else if(adcConfig->channel == CHANNEL_10){
-			ADC1->SMPR1 |= ADC_SMPR1_SMP10_0;
-			ADC1->SMPR1 |= ADC_SMPR1_SMP10_1;
-			ADC1->SMPR1 &= ~ADC_SMPR1_SMP10_2;
-
-		}else if(adcConfig->channel == CHANNEL_11){
-			ADC1->SMPR1 |= ADC_SMPR1_SMP11_0;
-			ADC1->SMPR1 |= ADC_SMPR1_SMP11_1;
-			ADC1->SMPR1 &= ~ADC_SMPR1_SMP11_2;
-
-		}else if(adcConfig->channel == CHANNEL_12){
-			ADC1->SMPR1 |= ADC_SMPR1_SMP12_0;
-			ADC1->SMPR1 |= ADC_SMPR1_SMP12_1;
-			ADC1->SMPR1 &= ~ADC_SMPR1_SMP12_2;
-
-		}else if(adcConfig->channel == CHANNEL_13){
-			ADC1->SMPR1 |= ADC_SMPR1_SMP13_0;
-			ADC1->SMPR1 |= ADC_SMPR1_SMP13_1;
-			ADC1->SMPR1 &= ~ADC_SMPR1_SMP13_2;
-
-		}else if(adcConfig->channel == CHANNEL_14){
-			ADC1->SMPR1 |= ADC_SMPR1_SMP14_0;
-			ADC1->SMPR1 |= ADC_SMPR1_SMP14_1;
-			ADC1->SMPR1 &= ~ADC_SMPR1_SMP14_2;
-
-		}else if(adcConfig->channel == CHANNEL_15){
-			ADC1->SMPR1 |= ADC_SMPR1_SMP15_0;
-			ADC1->SMPR1 |= ADC_SMPR1_SMP15_1;
-			ADC1->SMPR1 &= ~ADC_SMPR1_SMP15_2;
-		}
-		break;
-	}
-	case SAMPLING_PERIOD_84_CYCLES: {
-		if(adcConfig->channel == CHANNEL_0){
-			ADC1->SMPR2 &= ~ADC_SMPR2_SMP0_0;
-			ADC1->SMPR2 &= ~ADC_SMPR2_SMP0_1;
-			ADC1->SMPR2 |= ADC_SMPR2_SMP0_2;
-
-		}else if(adcConfig->channel == CHANNEL_1){
-			ADC1->SMPR2 &= ~ADC_SMPR2_SMP1_0;
-			ADC1->SMPR2 &= ~ADC_SMPR2_SMP1_1;
-			ADC1->SMPR2 |= ADC_SMPR2_SMP1_2;
-
-		}else if(adcConfig->channel == CHANNEL_2){
-			ADC1->SMPR2 &= ~ADC_SMPR2_SMP2_0;
-			ADC1->SMPR2 &= ~ADC_SMPR2_SMP2_1;
-			ADC1->SMPR2 |= ADC_SMPR2_SMP2_2;
-
-		}else if(adcConfig->channel == CHANNEL_3){
-			ADC1->SMPR2 &= ~ADC_SMPR2_SMP3_0;
-			ADC1->SMPR2 &= ~ADC_SMPR2_SMP3_1;
-			ADC1->SMPR2 |= ADC_SMPR2_SMP3_2;
-
-		}else if(adcConfig->channel == CHANNEL_4){
-			ADC1->SMPR2 &= ~ADC_SMPR2_SMP4_0;
-			ADC1->SMPR2 &= ~ADC_SMPR2_SMP4_1;
-			ADC1->SMPR2 |= ADC_SMPR2_SMP4_2;
-
-		}else if(adcConfig->channel == CHANNEL_5){
-			ADC1->SMPR2 &= ~ADC_SMPR2_SMP5_0;
-			ADC1->SMPR2 &= ~ADC_SMPR2_SMP5_1;
-			ADC1->SMPR2 |= ADC_SMPR2_SMP5_2;
-
-		}else if(adcConfig->channel == CHANNEL_6){
-			ADC1->SMPR2 &= ~ADC_SMPR2_SMP6_0;
-			ADC1->SMPR2 &= ~ADC_SMPR2_SMP6_1;
-			ADC1->SMPR2 |= ADC_SMPR2_SMP6_2;
-
-		}else if(adcConfig->channel == CHANNEL_7){
-			ADC1->SMPR2 &= ~ADC_SMPR2_SMP7_0;
-			ADC1->SMPR2 &= ~ADC_SMPR2_SMP7_1;
-			ADC1->SMPR2 |= ADC_SMPR2_SMP7_2;
-
-		}else if(adcConfig->channel == CHANNEL_8){
-			ADC1->SMPR2 &= ~ADC_SMPR2_SMP8_0;
-			ADC1->SMPR2 &= ~ADC_SMPR2_SMP8_1;
-			ADC1->SMPR2 |= ADC_SMPR2_SMP8_2;
-
-		}else if(adcConfig->channel == CHANNEL_9){
-			ADC1->SMPR2 &= ~ADC_SMPR2_SMP9_0;
-			ADC1->SMPR2 &= ~ADC_SMPR2_SMP9_1;
-			ADC1->SMPR2 |= ADC_SMPR2_SMP9_2;
-
-		}else if(adcConfig->channel == CHANNEL_10){
-			ADC1->SMPR1 &= ~ADC_SMPR1_SMP10_0;
-			ADC1->SMPR1 &= ~ADC_SMPR1_SMP10_1;
-			ADC1->SMPR1 |= ADC_SMPR1_SMP10_2;
-
-		}else if(adcConfig->channel == CHANNEL_11){
-			ADC1->SMPR1 &= ~ADC_SMPR1_SMP11_0;
-			ADC1->SMPR1 &= ~ADC_SMPR1_SMP11_1;
-			ADC1->SMPR1 |= ADC_SMPR1_SMP11_2;
-
-		}else if(adcConfig->channel == CHANNEL_12){
-			ADC1->SMPR1 &= ~ADC_SMPR1_SMP12_0;
-			ADC1->SMPR1 &= ~ADC_SMPR1_SMP12_1;
-			ADC1->SMPR1 |= ADC_SMPR1_SMP12_2;
-
-		}else if(adcConfig->channel == CHANNEL_13){
-			ADC1->SMPR1 &= ~ADC_SMPR1_SMP13_0;
-			ADC1->SMPR1 &= ~ADC_SMPR1_SMP13_1;
-			ADC1->SMPR1 |= ADC_SMPR1_SMP13_2;
-
-		}else if(adcConfig->channel == CHANNEL_14){
-			ADC1->SMPR1 &= ~ADC_SMPR1_SMP14_0;
-			ADC1->SMPR1 &= ~ADC_SMPR1_SMP14_1;
-			ADC1->SMPR1 |= ADC_SMPR1_SMP14_2;
-
-		}else if(adcConfig->channel == CHANNEL_15){
-			ADC1->SMPR1 &= ~ADC_SMPR1_SMP15_0;
-			ADC1->SMPR1 &= ~ADC_SMPR1_SMP15_1;
-			ADC1->SMPR1 |= ADC_SMPR1_SMP15_2;
-		}
-		break;
-	}
-	case SAMPLING_PERIOD_112_CYCLES: {
-		if(adcConfig->channel == CHANNEL_0){
-			ADC1->SMPR2 |= ADC_SMPR2_SMP0_0;
-			ADC1->SMPR2 &= ~ADC_SMPR2_SMP0_1;
-			ADC1->SMPR2 |= ADC_SMPR2_SMP0_2;
-
-		}else if(adcConfig->channel == CHANNEL_1){
-			ADC1->SMPR2 |= ADC_SMPR2_SMP1_0;
-			ADC1->SMPR2 &= ~ADC_SMPR2_SMP1_1;
-			ADC1->SMPR2 |= ADC_SMPR2_SMP1_2;
-
-		}else if(adcConfig->channel == CHANNEL_2){
-			ADC1->SMPR2 |= ADC_SMPR2_SMP2_0;
-			ADC1->SMPR2 &= ~ADC_SMPR2_SMP2_1;
-			ADC1->SMPR2 |= ADC_SMPR2_SMP2_2;
-
-		}else if(adcConfig->channel == CHANNEL_3){
-			ADC1->SMPR2 |= ADC_SMPR2_SMP3_0;
-			ADC1->SMPR2 &= ~ADC_SMPR2_SMP3_1;
-			ADC1->SMPR2 |= ADC_SMPR2_SMP3_2;
-
-		}else if(adcConfig->channel == CHANNEL_4){
-			ADC1->SMPR2 |= ADC_SMPR2_SMP4_0;
-			ADC1->SMPR2 &= ~ADC_SMPR2_SMP4_1;
-			ADC1->SMPR2 |= ADC_SMPR2_SMP4_2;
-
-		}else if(adcConfig->channel == CHANNEL_5){
-			ADC1->SMPR2 |= ADC_SMPR2_SMP5_0;
-			ADC1->SMPR2 &= ~ADC_SMPR2_SMP5_1;
-			ADC1->SMPR2 |= ADC_SMPR2_SMP5_2;
-
-		}else if(adcConfig->channel == CHANNEL_6){
-			ADC1->SMPR2 |= ADC_SMPR2_SMP6_0;
-			ADC1->SMPR2 &= ~ADC_SMPR2_SMP6_1;
-			ADC1->SMPR2 |= ADC_SMPR2_SMP6_2;
-
-		}else if(adcConfig->channel == CHANNEL_7){
-			ADC1->SMPR2 |= ADC_SMPR2_SMP7_0;
-			ADC1->SMPR2 &= ~ADC_SMPR2_SMP7_1;
-			ADC1->SMPR2 |= ADC_SMPR2_SMP7_2;
-
-		}else if(adcConfig->channel == CHANNEL_8){
-			ADC1->SMPR2 |= ADC_SMPR2_SMP8_0;
-			ADC1->SMPR2 &= ~ADC_SMPR2_SMP8_1;
-			ADC1->SMPR2 |= ADC_SMPR2_SMP8_2;
-
-		}else if(adcConfig->channel == CHANNEL_9){
-			ADC1->SMPR2 |= ADC_SMPR2_SMP9_0;
-			ADC1->SMPR2 &= ~ADC_SMPR2_SMP9_1;
-			ADC1->SMPR2 |= ADC_SMPR2_SMP9_2;
-
-		}else if(adcConfig->channel == CHANNEL_10){
-			ADC1->SMPR1 |= ADC_SMPR1_SMP10_0;
-			ADC1->SMPR1 &= ~ADC_SMPR1_SMP10_1;
-			ADC1->SMPR1 |= ADC_SMPR1_SMP10_2;
-
-		}else if(adcConfig->channel == CHANNEL_11){
-			ADC1->SMPR1 |= ADC_SMPR1_SMP11_0;
-			ADC1->SMPR1 &= ~ADC_SMPR1_SMP11_1;
-			ADC1->SMPR1 |= ADC_SMPR1_SMP11_2;
-
-		}else if(adcConfig->channel == CHANNEL_12){
-			ADC1->SMPR1 |= ADC_SMPR1_SMP12_0;
-			ADC1->SMPR1 &= ~ADC_SMPR1_SMP12_1;
-			ADC1->SMPR1 |= ADC_SMPR1_SMP12_2;
-
-		}else if(adcConfig->channel == CHANNEL_13){
-			ADC1->SMPR1 |= ADC_SMPR1_SMP13_0;
-			ADC1->SMPR1 &= ~ADC_SMPR1_SMP13_1;
-			ADC1->SMPR1 |= ADC_SMPR1_SMP13_2;
-
-		}else if(adcConfig->channel == CHANNEL_14){
-			ADC1->SMPR1 |= ADC_SMPR1_SMP14_0;
-			ADC1->SMPR1 &= ~ADC_SMPR1_SMP14_1;
-			ADC1->SMPR1 |= ADC_SMPR1_SMP14_2;
-
-		}else if(adcConfig->channel == CHANNEL_15){
-			ADC1->SMPR1 |= ADC_SMPR1_SMP15_0;
-			ADC1->SMPR1 &= ~ADC_SMPR1_SMP15_1;
-			ADC1->SMPR1 |= ADC_SMPR1_SMP15_2;
-		}
-		break;
-	}
-	case SAMPLING_PERIOD_144_CYCLES: {
-		if(adcConfig->channel == CHANNEL_0){
-			ADC1->SMPR2 &= ~ADC_SMPR2_SMP0_0;
-			ADC1->SMPR2 |= ADC_SMPR2_SMP0_1;
-			ADC1->SMPR2 |= ADC_SMPR2_SMP0_2;
-
-		}else if(adcConfig->channel == CHANNEL_1){
-			ADC1->SMPR2 &= ~ADC_SMPR2_SMP1_0;
-			ADC1->SMPR2 |= ADC_SMPR2_SMP1_1;
-			ADC1->SMPR2 |= ADC_SMPR2_SMP1_2;
-
-		}else if(adcConfig->channel == CHANNEL_2){
-			ADC1->SMPR2 &= ~ADC_SMPR2_SMP2_0;
-			ADC1->SMPR2 |= ADC_SMPR2_SMP2_1;
-			ADC1->SMPR2 |= ADC_SMPR2_SMP2_2;
-
-		}else if(adcConfig->channel == CHANNEL_3){
-			ADC1->SMPR2 &= ~ADC_SMPR2_SMP3_0;
-			ADC1->SMPR2 |= ADC_SMPR2_SMP3_1;
-			ADC1->SMPR2 |= ADC_SMPR2_SMP3_2;
-
-		}else if(adcConfig->channel == CHANNEL_4){
-			ADC1->SMPR2 &= ~ADC_SMPR2_SMP4_0;
-			ADC1->SMPR2 |= ADC_SMPR2_SMP4_1;
-			ADC1->SMPR2 |= ADC_SMPR2_SMP4_2;
-
-		}else if(adcConfig->channel == CHANNEL_5){
-			ADC1->SMPR2 &= ~ADC_SMPR2_SMP5_0;
-			ADC1->SMPR2 |= ADC_SMPR2_SMP5_1;
-			ADC1->SMPR2 |= ADC_SMPR2_SMP5_2;
-
-		}else if(adcConfig->channel == CHANNEL_6){
-			ADC1->SMPR2 &= ~ADC_SMPR2_SMP6_0;
-			ADC1->SMPR2 |= ADC_SMPR2_SMP6_1;
-			ADC1->SMPR2 |= ADC_SMPR2_SMP6_2;
-
-		}else if(adcConfig->channel == CHANNEL_7){
-			ADC1->SMPR2 &= ~ADC_SMPR2_SMP7_0;
-			ADC1->SMPR2 |= ADC_SMPR2_SMP7_1;
-			ADC1->SMPR2 |= ADC_SMPR2_SMP7_2;
-
-		}else if(adcConfig->channel == CHANNEL_8){
-			ADC1->SMPR2 &= ~ADC_SMPR2_SMP8_0;
-			ADC1->SMPR2 |= ADC_SMPR2_SMP8_1;
-			ADC1->SMPR2 |= ADC_SMPR2_SMP8_2;
-
-		}else if(adcConfig->channel == CHANNEL_9){
-			ADC1->SMPR2 &= ~ADC_SMPR2_SMP9_0;
-			ADC1->SMPR2 |= ADC_SMPR2_SMP9_1;
-			ADC1->SMPR2 |= ADC_SMPR2_SMP9_2;
-
-		}else if(adcConfig->channel == CHANNEL_10){
-			ADC1->SMPR1 &= ~ADC_SMPR1_SMP10_0;
-			ADC1->SMPR1 |= ADC_SMPR1_SMP10_1;
-			ADC1->SMPR1 |= ADC_SMPR1_SMP10_2;
-
-		}else if(adcConfig->channel == CHANNEL_11){
-			ADC1->SMPR1 &= ~ADC_SMPR1_SMP11_0;
-			ADC1->SMPR1 |= ADC_SMPR1_SMP11_1;
-			ADC1->SMPR1 |= ADC_SMPR1_SMP11_2;
-
-		}else if(adcConfig->channel == CHANNEL_12){
-			ADC1->SMPR1 &= ~ADC_SMPR1_SMP12_0;
-			ADC1->SMPR1 |= ADC_SMPR1_SMP12_1;
-			ADC1->SMPR1 |= ADC_SMPR1_SMP12_2;
-
-		}else if(adcConfig->channel == CHANNEL_13){
-			ADC1->SMPR1 &= ~ADC_SMPR1_SMP13_0;
-			ADC1->SMPR1 |= ADC_SMPR1_SMP13_1;
-			ADC1->SMPR1 |= ADC_SMPR1_SMP13_2;
-
-		}else if(adcConfig->channel == CHANNEL_14){
-			ADC1->SMPR1 &= ~ADC_SMPR1_SMP14_0;
-			ADC1->SMPR1 |= ADC_SMPR1_SMP14_1;
-			ADC1->SMPR1 |= ADC_SMPR1_SMP14_2;
-
-		}else if(adcConfig->channel == CHANNEL_15){
-			ADC1->SMPR1 &= ~ADC_SMPR1_SMP15_0;
-			ADC1->SMPR1 |= ADC_SMPR1_SMP15_1;
-			ADC1->SMPR1 |= ADC_SMPR1_SMP15_2;
-		}
-		break;
-	}
-	case SAMPLING_PERIOD_480_CYCLES: {
-		if(adcConfig->channel == CHANNEL_0){
-			ADC1->SMPR2 |= ADC_SMPR2_SMP0_0;
-			ADC1->SMPR2 |= ADC_SMPR2_SMP0_1;
-			ADC1->SMPR2 |= ADC_SMPR2_SMP0_2;
-
-		}else if(adcConfig->channel == CHANNEL_1){
-			ADC1->SMPR2 |= ADC_SMPR2_SMP1_0;
-			ADC1->SMPR2 |= ADC_SMPR2_SMP1_1;
-			ADC1->SMPR2 |= ADC_SMPR2_SMP1_2;
-
-		}else if(adcConfig->channel == CHANNEL_2){
-			ADC1->SMPR2 |= ADC_SMPR2_SMP2_0;
-			ADC1->SMPR2 |= ADC_SMPR2_SMP2_1;
-			ADC1->SMPR2 |= ADC_SMPR2_SMP2_2;
-
-		}else if(adcConfig->channel == CHANNEL_3){
-			ADC1->SMPR2 |= ADC_SMPR2_SMP3_0;
-			ADC1->SMPR2 |= ADC_SMPR2_SMP3_1;
-			ADC1->SMPR2 |= ADC_SMPR2_SMP3_2;
-
-		}else if(adcConfig->channel == CHANNEL_4){
-			ADC1->SMPR2 |= ADC_SMPR2_SMP4_0;
-			ADC1->SMPR2 |= ADC_SMPR2_SMP4_1;
-			ADC1->SMPR2 |= ADC_SMPR2_SMP4_2;
-
-		}else if(adcConfig->channel == CHANNEL_5){
-			ADC1->SMPR2 |= ADC_SMPR2_SMP5_0;
-			ADC1->SMPR2 |= ADC_SMPR2_SMP5_1;
-			ADC1->SMPR2 |= ADC_SMPR2_SMP5_2;
-
-		}else if(adcConfig->channel == CHANNEL_6){
-			ADC1->SMPR2 |= ADC_SMPR2_SMP6_0;
-			ADC1->SMPR2 |= ADC_SMPR2_SMP6_1;
-			ADC1->SMPR2 |= ADC_SMPR2_SMP6_2;
-
-		}else if(adcConfig->channel == CHANNEL_7){
-			ADC1->SMPR2 |= ADC_SMPR2_SMP7_0;
-			ADC1->SMPR2 |= ADC_SMPR2_SMP7_1;
-			ADC1->SMPR2 |= ADC_SMPR2_SMP7_2;
-
-		}else if(adcConfig->channel == CHANNEL_8){
-			ADC1->SMPR2 |= ADC_SMPR2_SMP8_0;
-			ADC1->SMPR2 |= ADC_SMPR2_SMP8_1;
-			ADC1->SMPR2 |= ADC_SMPR2_SMP8_2;
-
-		}else if(adcConfig->channel == CHANNEL_9){
-			ADC1->SMPR2 |= ADC_SMPR2_SMP9_0;
-			ADC1->SMPR2 |= ADC_SMPR2_SMP9_1;
-			ADC1->SMPR2 |= ADC_SMPR2_SMP9_2;
-
-		}else if(adcConfig->channel == CHANNEL_10){
-			ADC1->SMPR1 |= ADC_SMPR1_SMP10_0;
-			ADC1->SMPR1 |= ADC_SMPR1_SMP10_1;
-			ADC1->SMPR1 |= ADC_SMPR1_SMP10_2;
-
-		}else if(adcConfig->channel == CHANNEL_11){
-			ADC1->SMPR1 |= ADC_SMPR1_SMP11_0;
-			ADC1->SMPR1 |= ADC_SMPR1_SMP11_1;
-			ADC1->SMPR1 |= ADC_SMPR1_SMP11_2;
-
-		}else if(adcConfig->channel == CHANNEL_12){
-			ADC1->SMPR1 |= ADC_SMPR1_SMP12_0;
-			ADC1->SMPR1 |= ADC_SMPR1_SMP12_1;
-			ADC1->SMPR1 |= ADC_SMPR1_SMP12_2;
-
-		}else if(adcConfig->channel == CHANNEL_13){
-			ADC1->SMPR1 |= ADC_SMPR1_SMP13_0;
-			ADC1->SMPR1 |= ADC_SMPR1_SMP13_1;
-			ADC1->SMPR1 |= ADC_SMPR1_SMP13_2;
-
-		}else if(adcConfig->channel == CHANNEL_14){
-			ADC1->SMPR1 |= ADC_SMPR1_SMP14_0;
-			ADC1->SMPR1 |= ADC_SMPR1_SMP14_1;
-			ADC1->SMPR1 |= ADC_SMPR1_SMP14_2;
-
-		}else if(adcConfig->channel == CHANNEL_15){
-			ADC1->SMPR1 |= ADC_SMPR1_SMP15_0;
-			ADC1->SMPR1 |= ADC_SMPR1_SMP15_1;
-			ADC1->SMPR1 |= ADC_SMPR1_SMP15_2;
-		}
-		break;
-	}
-	default:{
-		if(adcConfig->channel == CHANNEL_0){
-			ADC1->SMPR2 &= ~ADC_SMPR2_SMP0_0;
-			ADC1->SMPR2 &= ~ADC_SMPR2_SMP0_1;
-			ADC1->SMPR2 |= ADC_SMPR2_SMP0_2;
-
-		}else if(adcConfig->channel == CHANNEL_1){
-			ADC1->SMPR2 &= ~ADC_SMPR2_SMP1_0;
-			ADC1->SMPR2 &= ~ADC_SMPR2_SMP1_1;
-			ADC1->SMPR2 |= ADC_SMPR2_SMP1_2;
-
-		}else if(adcConfig->channel == CHANNEL_2){
-			ADC1->SMPR2 &= ~ADC_SMPR2_SMP2_0;
-			ADC1->SMPR2 &= ~ADC_SMPR2_SMP2_1;
-			ADC1->SMPR2 |= ADC_SMPR2_SMP2_2;
-
-		}else if(adcConfig->channel == CHANNEL_3){
-			ADC1->SMPR2 &= ~ADC_SMPR2_SMP3_0;
-			ADC1->SMPR2 &= ~ADC_SMPR2_SMP3_1;
-			ADC1->SMPR2 |= ADC_SMPR2_SMP3_2;
-
-		}else if(adcConfig->channel == CHANNEL_4){
-			ADC1->SMPR2 &= ~ADC_SMPR2_SMP4_0;
-			ADC1->SMPR2 &= ~ADC_SMPR2_SMP4_1;
-			ADC1->SMPR2 |= ADC_SMPR2_SMP4_2;
-
-		}else if(adcConfig->channel == CHANNEL_5){
-			ADC1->SMPR2 &= ~ADC_SMPR2_SMP5_0;
-			ADC1->SMPR2 &= ~ADC_SMPR2_SMP5_1;
-			ADC1->SMPR2 |= ADC_SMPR2_SMP5_2;
-
-		}else if(adcConfig->channel == CHANNEL_6){
-			ADC1->SMPR2 &= ~ADC_SMPR2_SMP6_0;
-			ADC1->SMPR2 &= ~ADC_SMPR2_SMP6_1;
-			ADC1->SMPR2 |= ADC_SMPR2_SMP6_2;
-
-		}else if(adcConfig->channel == CHANNEL_7){
-			ADC1->SMPR2 &= ~ADC_SMPR2_SMP7_0;
-			ADC1->SMPR2 &= ~ADC_SMPR2_SMP7_1;
-			ADC1->SMPR2 |= ADC_SMPR2_SMP7_2;
-
-		}else if(adcConfig->channel == CHANNEL_8){
-			ADC1->SMPR2 &= ~ADC_SMPR2_SMP8_0;
-			ADC1->SMPR2 &= ~ADC_SMPR2_SMP8_1;
-			ADC1->SMPR2 |= ADC_SMPR2_SMP8_2;
-
-		}else if(adcConfig->channel == CHANNEL_9){
-			ADC1->SMPR2 &= ~ADC_SMPR2_SMP9_0;
-			ADC1->SMPR2 &= ~ADC_SMPR2_SMP9_1;
-			ADC1->SMPR2 |= ADC_SMPR2_SMP9_2;
-
-		}else if(adcConfig->channel == CHANNEL_10){
-			ADC1->SMPR1 &= ~ADC_SMPR1_SMP10_0;
-			ADC1->SMPR1 &= ~ADC_SMPR1_SMP10_1;
-			ADC1->SMPR1 |= ADC_SMPR1_SMP10_2;
-
-		}else if(adcConfig->channel == CHANNEL_11){
-			ADC1->SMPR1 &= ~ADC_SMPR1_SMP11_0;
-			ADC1->SMPR1 &= ~ADC_SMPR1_SMP11_1;
-			ADC1->SMPR1 |= ADC_SMPR1_SMP11_2;
-
-		}else if(adcConfig->channel == CHANNEL_12){
-			ADC1->SMPR1 &= ~ADC_SMPR1_SMP12_0;
-			ADC1->SMPR1 &= ~ADC_SMPR1_SMP12_1;
-			ADC1->SMPR1 |= ADC_SMPR1_SMP12_2;
-
-		}else if(adcConfig->channel == CHANNEL_13){
-			ADC1->SMPR1 &= ~ADC_SMPR1_SMP13_0;
-			ADC1->SMPR1 &= ~ADC_SMPR1_SMP13_1;
-			ADC1->SMPR1 |= ADC_SMPR1_SMP13_2;
-
-		}else if(adcConfig->channel == CHANNEL_14){
-			ADC1->SMPR1 &= ~ADC_SMPR1_SMP14_0;
-			ADC1->SMPR1 &= ~ADC_SMPR1_SMP14_1;
-			ADC1->SMPR1 |= ADC_SMPR1_SMP14_2;
-
-		}else if(adcConfig->channel == CHANNEL_15){
-			ADC1->SMPR1 &= ~ADC_SMPR1_SMP15_0;
-			ADC1->SMPR1 &= ~ADC_SMPR1_SMP15_1;
-			ADC1->SMPR1 |= ADC_SMPR1_SMP15_2;
-		}
-		break;
+	uint8_t auxPeriod = (uint8_t)adcConfig->samplingPeriod;
+
+	if(adcConfig->channel > CHANNEL_15){
+		return;
 	}
+
+	/* Un valor fuera de rango se toma como 84 ciclos */
+	if(adcConfig->samplingPeriod > SAMPLING_PERIOD_480_CYCLES){
+		auxPeriod = SAMPLING_PERIOD_84_CYCLES;
 	}
+
+	adc_set_channel_sampling(adcConfig->channel, auxPeriod);
 }
 
 
@@ -917,139 +227,9 @@ static void adc_set_sampling_and_hold(ADC_Config_t *adcConfig){
 static void adc_set_one_channel_sequence(ADC_Config_t *adcConfig){
 
 	ADC1->SQR1 &= ~ADC_SQR1_L;
-	switch(adcConfig->channel){
-
-	case CHANNEL_0:{
-		ADC1->SQR3 &= ~ADC_SQR1_SQ13_0;
-		ADC1->SQR3 &= ~ADC_SQR1_SQ13_1;
-		ADC1->SQR3 &= ~ADC_SQR1_SQ13_2;
-		ADC1->SQR3 &= ~ADC_SQR1_SQ13_3;
-		ADC1->SQR3 &= ~ADC_SQR1_SQ13_4;
-		break;
-	}
-	case CHANNEL_1:{
-		ADC1->SQR3 |= ADC_SQR1_SQ13_0;
-		ADC1->SQR3 &= ~ADC_SQR1_SQ13_1;
-		ADC1->SQR3 &= ~ADC_SQR1_SQ13_2;
-		ADC1->SQR3 &= ~ADC_SQR1_SQ13_3;
-		ADC1->SQR3 &= ~ADC_SQR1_SQ13_4;
-		break;
-	}
-	case CHANNEL_2:{
-		ADC1->SQR3 &= ~ADC_SQR1_SQ13_0;
-		ADC1->SQR3 |= ADC_SQR1_SQ13_1;
-		ADC1->SQR3 &= ~ADC_SQR1_SQ13_2;
-		ADC1->SQR3 &= ~ADC_SQR1_SQ13_3;
-		ADC1->SQR3 &= ~ADC_SQR1_SQ13_4;
-		break;
-	}
-	case CHANNEL_3:{
-		ADC1->SQR3 |= ADC_SQR1_SQ13_0;
-		ADC1->SQR3 |= ADC_SQR1_SQ13_1;
-		ADC1->SQR3 &= ~ADC_SQR1_SQ13_2;
-		ADC1->SQR3 &= ~ADC_SQR1_SQ13_3;
-		ADC1->SQR3 &= ~ADC_SQR1_SQ13_4;
-		break;
-	}
-	case CHANNEL_4:{
-		ADC1->SQR3 &= ~ADC_SQR1_SQ13_0;
-		ADC1->SQR3 &= ~ADC_SQR1_SQ13_1;
-		ADC1->SQR3 |= ADC_SQR1_SQ13_2;
-		ADC1->SQR3 &= ~ADC_SQR1_SQ13_3;
-		ADC1->SQR3 &= ~ADC_SQR1_SQ13_4;
-		break;
-	}
-	case CHANNEL_5:{
-		ADC1->SQR3 |= ADC_SQR1_SQ13_0;
-		ADC1->SQR3 &= ~ADC_SQR1_SQ13_1;
-		ADC1->SQR3 |= ADC_SQR1_SQ13_2;
-		ADC1->SQR3 &= ~ADC_SQR1_SQ13_3;
-		ADC1->SQR3 &= ~ADC_SQR1_SQ13_4;
-		break;
-	}
-	case CHANNEL_6:{
-		ADC1->SQR3 &= ~ADC_SQR1_SQ13_0;
-		ADC1->SQR3 |= ADC_SQR1_SQ13_1;
-		ADC1->SQR3 |= ADC_SQR1_SQ13_2;
-		ADC1->SQR3 &= ~ADC_SQR1_SQ13_3;
-		ADC1->SQR3 &= ~ADC_SQR1_SQ13_4;
-		break;
-	}
-	case CHANNEL_7:{
-		ADC1->SQR3 |= ADC_SQR1_SQ13_0;
-		ADC1->SQR3 |= ADC_SQR1_SQ13_1;
-		ADC1->SQR3 |= ADC_SQR1_SQ13_2;
-		ADC1->SQR3 &= ~ADC_SQR1_SQ13_3;
-		ADC1->SQR3 &= ~ADC_SQR1_SQ13_4;
-		break;
-	}
-	case CHANNEL_8:{
-		ADC1->SQR3 &= ~ADC_SQR1_SQ13_0;
-		ADC1->SQR3 &= ~ADC_SQR1_SQ13_1;
-		ADC1->SQR3 &= ~ADC_SQR1_SQ13_2;
-		ADC1->SQR3 |= ADC_SQR1_SQ13_3;
-		ADC1->SQR3 &= ~ADC_SQR1_SQ13_4;
-		break;
-	}
-	case CHANNEL_9:{
-		ADC1->SQR3 |= ADC_SQR1_SQ13_0;
-		ADC1->SQR3 &= ~ADC_SQR1_SQ13_1;
-		ADC1->SQR3 &= ~ADC_SQR1_SQ13_2;
-		ADC1->SQR3 |= ADC_SQR1_SQ13_3;
-		ADC1->SQR3 &= ~ADC_SQR1_SQ13_4;
-		break;
-	}
-	case CHANNEL_10:{
-		ADC1->SQR3 &= ~ADC_SQR1_SQ13_0;
-		ADC1->SQR3 |= ADC_SQR1_SQ13_1;
-		ADC1->SQR3 &= ~ADC_SQR1_SQ13_2;
-		ADC1->SQR3 |= ADC_SQR1_SQ13_3;
-		ADC1->SQR3 &= ~ADC_SQR1_SQ13_4;
-		break;
-	}
-	case CHANNEL_11:{
-		ADC1->SQR3 |= ADC_SQR1_SQ13_0;
-		ADC1->SQR3 |= ADC_SQR1_SQ13_1;
-		ADC1->SQR3 &= ~ADC_SQR1_SQ13_2;
-		ADC1->SQR3 |= ADC_SQR1_SQ13_3;
-		ADC1->SQR3 &= ~ADC_SQR1_SQ13_4;
-		break;
-	}
-	case CHANNEL_12:{
-		ADC1->SQR3 &= ~ADC_SQR1_SQ13_0;
-		ADC1->SQR3 &= ~ADC_SQR1_SQ13_1;
-		ADC1->SQR3 |= ADC_SQR1_SQ13_2;
-		ADC1->SQR3 |= ADC_SQR1_SQ13_3;
-		ADC1->SQR3 &= ~ADC_SQR1_SQ13_4;
-		break;
-	}
-	case CHANNEL_13:{
-		ADC1->SQR3 |= ADC_SQR1_SQ13_0;
-		ADC1->SQR3 &= ~ADC_SQR1_SQ13_1;
-		ADC1->SQR3 |= ADC_SQR1_SQ13_2;
-		ADC1->SQR3 |= ADC_SQR1_SQ13_3;
-		ADC1->SQR3 &= ~ADC_SQR1_SQ13_4;
-		break;
-	}
-	case CHANNEL_14:{
-		ADC1->SQR3 &= ~ADC_SQR1_SQ13_0;
-		ADC1->SQR3 |= ADC_SQR1_SQ13_1;
-		ADC1->SQR3 |= ADC_SQR1_SQ13_2;
-		ADC1->SQR3 |= ADC_SQR1_SQ13_3;
-		ADC1->SQR3 &= ~ADC_SQR1_SQ13_4;
-		break;
-	}
-	case CHANNEL_15:{
-		ADC1->SQR3 |= ADC_SQR1_SQ13_0;
-		ADC1->SQR3 |= ADC_SQR1_SQ13_1;
-		ADC1->SQR3 |= ADC_SQR1_SQ13_2;
-		ADC1->SQR3 |= ADC_SQR1_SQ13_3;
-		ADC1->SQR3 &= ~ADC_SQR1_SQ13_4;
-		break;
-	}
-	default:{
-		break;
-	}
+
+	if(adcConfig->channel <= CHANNEL_15){
+		adc_set_sequence_rank(0, adcConfig->channel);
 	}
 }
 
@@ -1118,6 +298,108 @@ void adc_ScanMode(uint8_t state){
  *Función que comienza la conversión ADC simple
  * */
 void adc_StartSingleConv(void){
+	adc_start_single_conversion();
+}
+
+/*
+ * Conversión simple de un canal, esperando a que termine. Solo se cambia el canal
+ * de la secuencia (SQR3): el pin, la resolución y el tiempo de muestreo del canal
+ * deben haberse cargado antes con adc_ConfigSingleChannel().
+ * Si la interrupción EOC está activa el dato lo lee el ISR (y se llama al callback);
+ * en ese caso no se debe llamar desde un ISR de prioridad igual o mayor a la del ADC.
+ */
+uint8_t adc_ReadChannel(uint8_t channel, uint16_t *pData){
+
+	Deadline_t deadline = {0};
+	uint32_t   auxSequence = 0;
+	uint8_t    auxStatus   = ADC_READ_PENDING;
+
+	auxSequence = adc_StartReadChannel(channel);
+	if(auxSequence == 0){
+		return ADC_READ_BUSY;
+	}
+
+	deadline = deadline_Start(ADC_TIMEOUT_US);
+
+	while(1){
+
+		auxStatus = adc_GetResult(auxSequence, pData);
+		if(auxStatus != ADC_READ_PENDING){
+			return auxStatus;
+		}
+
+		if(deadline_Expired(&deadline)){
+			return ADC_READ_TIMEOUT;
+		}
+	}
+}
+
+/*
+ * Inicia la conversión simple de un canal sin esperar a que termine.
+ * Retorna el número de secuencia de la conversión, para consultarla con adc_GetResult(),
+ * o 0 si el ADC está ocupado en modo scan o streaming.
+ */
+uint32_t adc_StartReadChannel(uint8_t channel){
+
+	if((ADC1->CR2 & ADC_CR2_DMA) || (channel > CHANNEL_15)){
+		return 0;
+	}
+
+	/* Secuencia de un solo elemento con el canal pedido */
+	ADC1->SQR1 &= ~ADC_SQR1_L;
+	adc_set_sequence_rank(0, channel);
+
+	return adc_start_single_conversion();
+}
+
+/*
+ * Consulta la conversión con número sequence. Con ADC_READ_OK se entrega el dato en pData.
+ * El driver solo guarda el último dato: si terminó una conversión posterior se
+ * retorna ADC_READ_OVERWRITTEN.
+ * Sin la interrupción EOC el fin de conversión se detecta aquí, con la bandera EOC,
+ * por lo que basta con llamar esta función hasta que deje de retornar ADC_READ_PENDING.
+ */
+uint8_t adc_GetResult(uint32_t sequence, uint16_t *pData){
+
+	uint8_t auxStatus = ADC_READ_PENDING;
+
+	/* El ISR no debe cambiar el dato entre la comparación y la copia */
+	__disable_irq();
+
+	/* Sin EOCIE nadie más lee el DR: la conversión que terminó es la última iniciada */
+	if(!(ADC1->CR1 & ADC_CR1_EOCIE) && (ADC1->SR & ADC_SR_EOC)){
+		adcRawData           = ADC1->DR;
+		adcSequenceCompleted = adcSequenceStarted;
+	}
+
+	if(adcSequenceCompleted == sequence){
+		*pData    = adcRawData;
+		auxStatus = ADC_READ_OK;
+	}
+	else if((int32_t)(adcSequenceCompleted - sequence) > 0){
+		auxStatus = ADC_READ_OVERWRITTEN;
+	}
+	__enable_irq();
+
+	return auxStatus;
+}
+
+/*
+ * Inicia una conversión simple y le asigna un número de secuencia (nunca 0).
+ * Se baja EOC leyendo el DR para que no se confunda un dato viejo con el nuevo.
+ */
+static uint32_t adc_start_single_conversion(void){
+
+	uint32_t auxSequence = adcSequenceStarted + 1;
+
+	if(auxSequence == 0){
+		auxSequence = 1;
+	}
+
+	__disable_irq();
+	(void)ADC1->DR;
+	adcSequenceStarted = auxSequence;
+	__enable_irq();
 
 	//Se inicializa la conversión ADC simple
 	ADC1->CR2 &= ~ADC_CR2_CONT;
@@ -1125,6 +407,7 @@ void adc_StartSingleConv(void){
 	//Se inicializa la conversión ADC
 	ADC1->CR2 |= ADC_CR2_SWSTART;
 
+	return auxSequence;
 }
 
 
@@ -1153,12 +436,26 @@ void adc_StopContinuousConv(void){
 
 
 /*
- * Funcion que retorna el último dato adquirido por la ADC
+ * Funcion que retorna el último dato adquirido por la ADC.
+ * Es el de la última conversión terminada: justo después de adc_StartSingleConv()
+ * todavía es el dato anterior (ver adc_ReadChannel)
  * */
 uint16_t adc_Get_Value(void){
 	return adcRawData;
 }
 
+/*
+ * Registra la función que se llama al terminar cada conversión, junto con un puntero
+ * de contexto. Con callback = 0 se vuelve a llamar la función adc_CompleteCallback().
+ */
+void adc_RegisterCallback(ADC_Callback_t callback, void *pContext){
+
+	/* El ISR no debe ver la función nueva con el contexto viejo */
+	__disable_irq();
+	adcCallback        = callback;
+	adcCallbackContext = pContext;
+	__enable_irq();
+}
 
 __attribute__ ((weak)) void adc_CompleteCallback(void){
 	__NOP();
@@ -1169,12 +466,70 @@ __attribute__ ((weak)) void adc_CompleteCallback(void){
  * */
 void ADC_IRQHandler(void){
 
-	if(ADC1->CR1 & ADC_CR1_EOCIE){
+	uint8_t auxIndex = 0;
+
+	/* Overrun: el DMA no alcanzó a leer el DR y el ADC dejó de hacer peticiones.
+	 * Se reinicia el streaming desde el bloque A y se descarta el bloque publicado */
+	if((ADC1->CR1 & ADC_CR1_OVRIE) && (ADC1->SR & ADC_SR_OVR)){
+
+		ADC1->SR &= ~ADC_SR_OVR;
+
+		if(ptrADCStream != 0){
+			ptrADCStream->adcOverruns++;
+			ptrADCStream->pReadyBlock  = 0;
+			ptrADCStream->blockPending = 0;
+
+			adc_start_dma_requests(ptrADCStream->pBuffer, 2 * ptrADCStream->blockLength, ADC_SCAN_CONTINUOUS);
+		}
+	}
+
+	/* Watchdog analógico: se desactiva su interrupción hasta que la aplicación lo vuelva
+	 * a armar, pues mientras la señal siga fuera de la banda cada conversión la levanta */
+	if((ADC1->CR1 & ADC_CR1_AWDIE) && (ADC1->SR & ADC_SR_AWD)){
+
+		ADC1->SR  &= ~ADC_SR_AWD;
+		ADC1->CR1 &= ~ADC_CR1_AWDIE;
+
+		if(adcWatchdogCallback != 0){
+			adcWatchdogCallback(adcWatchdogCallbackContext);
+		}
+		else{
+			adc_WatchdogCallback();
+		}
+	}
+
+	/* Fin del grupo inyectado: los datos se copian de JDR1 ... JDR4 */
+	if((ADC1->CR1 & ADC_CR1_JEOCIE) && (ADC1->SR & ADC_SR_JEOC)){
+
+		ADC1->SR &= ~(ADC_SR_JEOC | ADC_SR_JSTRT);
+
+		if(ptrADCInjected != 0){
+			for(auxIndex = 0; auxIndex < ptrADCInjected->numberOfChannels; auxIndex++){
+				ptrADCInjected->data[auxIndex] = (int16_t)(&ADC1->JDR1)[auxIndex];
+			}
+
+			if(adcInjectedCallback != 0){
+				adcInjectedCallback(adcInjectedCallbackContext, ptrADCInjected);
+			}
+			else{
+				adc_InjectedCallback();
+			}
+		}
+	}
+
+	/* Se revisa la bandera EOC, no solo el enable: el ISR también se ejecuta por overrun */
+	if((ADC1->CR1 & ADC_CR1_EOCIE) && (ADC1->SR & ADC_SR_EOC)){
 		//Bajamos la bandera leyendo el dato
-		adcRawData = ADC1->DR;
+		adcRawData           = ADC1->DR;
+		adcSequenceCompleted = adcSequenceStarted;
 
-		//Se llama al callback
-		adc_CompleteCallback();
+		//Se llama al callback registrado, o al callback "weak" si no hay ninguno
+		if(adcCallback != 0){
+			adcCallback(adcCallbackContext, adcRawData);
+		}
+		else{
+			adc_CompleteCallback();
+		}
 	}
 }
 
@@ -1184,127 +539,815 @@ void ADC_IRQHandler(void){
  * */
 void adc_ConfigAnalogPin(uint8_t adcChannel){
 
-	switch(adcChannel){
-
-	case CHANNEL_0:{
-		handlerADCPin.pGPIOx                    = GPIOA;
-		handlerADCPin.pinConfig.GPIO_PinMode    = GPIO_MODE_ANALOG;
-		handlerADCPin.pinConfig.GPIO_PinNumber  = PIN_0;
-		gpio_Config(&handlerADCPin);
-		break;
-	}
-	case CHANNEL_1:{
-		handlerADCPin.pGPIOx                    = GPIOA;
-		handlerADCPin.pinConfig.GPIO_PinMode    = GPIO_MODE_ANALOG;
-		handlerADCPin.pinConfig.GPIO_PinNumber  = PIN_1;
-		gpio_Config(&handlerADCPin);
-		break;
-	}
-	case CHANNEL_2:{
+	/* Canales 0 - 7 en PA0 - PA7, 8 - 9 en PB0 - PB1 y 10 - 15 en PC0 - PC5 */
+	if(adcChannel <= CHANNEL_7){
 		handlerADCPin.pGPIOx                    = GPIOA;
-		handlerADCPin.pinConfig.GPIO_PinMode    = GPIO_MODE_ANALOG;
-		handlerADCPin.pinConfig.GPIO_PinNumber  = PIN_2;
-		gpio_Config(&handlerADCPin);
-		break;
+		handlerADCPin.pinConfig.GPIO_PinNumber  = adcChannel;
 	}
-	case CHANNEL_3:{
-		handlerADCPin.pGPIOx                    = GPIOA;
-		handlerADCPin.pinConfig.GPIO_PinMode    = GPIO_MODE_ANALOG;
-		handlerADCPin.pinConfig.GPIO_PinNumber  = PIN_3;
-		gpio_Config(&handlerADCPin);
-		break;
+	else if(adcChannel <= CHANNEL_9){
+		handlerADCPin.pGPIOx                    = GPIOB;
+		handlerADCPin.pinConfig.GPIO_PinNumber  = adcChannel - CHANNEL_8;
 	}
-	case CHANNEL_4:{
-		handlerADCPin.pGPIOx                    = GPIOA;
-		handlerADCPin.pinConfig.GPIO_PinMode    = GPIO_MODE_ANALOG;
-		handlerADCPin.pinConfig.GPIO_PinNumber  = PIN_4;
-		gpio_Config(&handlerADCPin);
-		break;
+	else if(adcChannel <= CHANNEL_15){
+		handlerADCPin.pGPIOx                    = GPIOC;
+		handlerADCPin.pinConfig.GPIO_PinNumber  = adcChannel - CHANNEL_10;
 	}
-	case CHANNEL_5:{
-		handlerADCPin.pGPIOx                    = GPIOA;
-		handlerADCPin.pinConfig.GPIO_PinMode    = GPIO_MODE_ANALOG;
-		handlerADCPin.pinConfig.GPIO_PinNumber  = PIN_5;
-		gpio_Config(&handlerADCPin);
-		break;
+	else{
+		return;
 	}
-	case CHANNEL_6:{
-		handlerADCPin.pGPIOx                    = GPIOA;
-		handlerADCPin.pinConfig.GPIO_PinMode    = GPIO_MODE_ANALOG;
-		handlerADCPin.pinConfig.GPIO_PinNumber  = PIN_6;
-		gpio_Config(&handlerADCPin);
-		break;
+
+	handlerADCPin.pinConfig.GPIO_PinMode    = GPIO_MODE_ANALOG;
+	gpio_Config(&handlerADCPin);
+}
+
+
+/*Configuración para hacer conversiones en multiples canales y en un orden específico*/
+
+/*
+ * Configura una secuencia regular de numeroDeCanales canales (máximo 16).
+ * adcConfig es un arreglo con un elemento por posición de la secuencia: el canal y su
+ * tiempo de muestreo. La resolución y la alineación se toman del primer elemento.
+ * Las muestras se llevan por DMA a un arreglo del usuario (ver adc_StartScan), por lo
+ * que la interrupción EOC no se utiliza en este modo.
+ */
+void adc_ConfigMultiChannel(ADC_Config_t *adcConfig, uint8_t numeroDeCanales){
+
+	uint8_t auxIndex = 0;
+
+	if(numeroDeCanales == 0){
+		return;
 	}
-	case CHANNEL_7:{
-		handlerADCPin.pGPIOx                    = GPIOA;
-		handlerADCPin.pinConfig.GPIO_PinMode    = GPIO_MODE_ANALOG;
-		handlerADCPin.pinConfig.GPIO_PinNumber  = PIN_7;
-		gpio_Config(&handlerADCPin);
-		break;
+	if(numeroDeCanales > ADC_MAX_SEQUENCE_LENGTH){
+		numeroDeCanales = ADC_MAX_SEQUENCE_LENGTH;
 	}
-	case CHANNEL_8:{
-		handlerADCPin.pGPIOx                    = GPIOB;
-		handlerADCPin.pinConfig.GPIO_PinMode    = GPIO_MODE_ANALOG;
-		handlerADCPin.pinConfig.GPIO_PinNumber  = PIN_0;
-		gpio_Config(&handlerADCPin);
-		break;
+
+	/* 1. Configuramos los pines de todos los canales como análogos */
+	for(auxIndex = 0; auxIndex < numeroDeCanales; auxIndex++){
+		adc_ConfigAnalogPin(adcConfig[auxIndex].channel);
 	}
-	case CHANNEL_9:{
-		handlerADCPin.pGPIOx                    = GPIOB;
-		handlerADCPin.pinConfig.GPIO_PinMode    = GPIO_MODE_ANALOG;
-		handlerADCPin.pinConfig.GPIO_PinNumber  = PIN_1;
-		gpio_Config(&handlerADCPin);
-		break;
+
+	/* 2. Activamos la señal de reloj para el ADC */
+	adc_enable_clock_peripheral();
+
+	//Limpiamos los registros antes de comenzar a configurar
+	ADC1->CR1 = 0;
+	ADC1->CR2 = 0;
+
+	/* 3. Resolución y alineación, comunes a toda la secuencia */
+	adc_set_resolution(&adcConfig[0]);
+	adc_set_alignment(&adcConfig[0]);
+
+	/* 4. Activamos el modo Scan, el continuo lo decide adc_StartScan() */
+	adc_ScanMode(SCAN_ON);
+	adc_StopContinuousConv();
+
+	/* 5. Tiempo de muestreo de cada canal y su posición en la secuencia.
+	 * Si un canal se repite en la secuencia, queda con el último tiempo de muestreo */
+	for(auxIndex = 0; auxIndex < numeroDeCanales; auxIndex++){
+		adc_set_channel_sampling(adcConfig[auxIndex].channel, adcConfig[auxIndex].samplingPeriod);
+		adc_set_sequence_rank(auxIndex, adcConfig[auxIndex].channel);
 	}
-	case CHANNEL_10:{
-		handlerADCPin.pGPIOx                    = GPIOC;
-		handlerADCPin.pinConfig.GPIO_PinMode    = GPIO_MODE_ANALOG;
-		handlerADCPin.pinConfig.GPIO_PinNumber  = PIN_0;
-		gpio_Config(&handlerADCPin);
-		break;
+
+	/* 6. Número de conversiones de la secuencia (L = n - 1) */
+	ADC1->SQR1 &= ~ADC_SQR1_L;
+	ADC1->SQR1 |= ((uint32_t)(numeroDeCanales - 1) << ADC_SQR1_L_Pos);
+	adcScanLength = numeroDeCanales;
+
+	/* 7. Prescaler del ADC en 2:1 */
+	ADC->CCR &= ~ADC_CCR_ADCPRE;
+
+	/* 8. Desactivamos las interrupciones globales */
+	__disable_irq();
+
+	/* 9. La interrupción EOC se remueve del NVIC y se configura el stream del DMA */
+	ADC1->CR1 &= ~ADC_CR1_EOCIE;
+	NVIC_DisableIRQ(ADC_IRQn);
+	adc_config_dma(DMA_INT_DISABLE);
+
+	/* 10. Activamos el modulo ADC */
+	adc_peripheralOnOFF(ADC_ON);
+
+	/* 11. Activamos las interrupciones globales */
+	__enable_irq();
+}
+
+/*
+ * Inicia la secuencia configurada con adc_ConfigMultiChannel(). pSamples debe tener
+ * espacio para una muestra por cada canal de la secuencia y debe existir mientras
+ * el modo scan esté activo.
+ * Con ADC_SCAN_SINGLE se convierte una sola secuencia; con ADC_SCAN_CONTINUOUS la
+ * secuencia se repite y el arreglo se sobrescribe en cada vuelta.
+ * Si se configuró un trigger externo (adc_ConfigTrigger) el DMA queda esperando y
+ * cada evento del timer convierte una secuencia.
+ */
+void adc_StartScan(uint16_t *pSamples, uint8_t scanMode){
+
+	if((adcScanLength == 0) || (pSamples == 0)){
+		return;
 	}
-	case CHANNEL_11:{
-		handlerADCPin.pGPIOx                    = GPIOC;
-		handlerADCPin.pinConfig.GPIO_PinMode    = GPIO_MODE_ANALOG;
-		handlerADCPin.pinConfig.GPIO_PinNumber  = PIN_1;
-		gpio_Config(&handlerADCPin);
-		break;
+
+	/* Si antes se usó el streaming (o el sobremuestreo), el stream del DMA tiene activa la interrupción HT */
+	if(ptrADCStream != 0){
+		adc_StopStream();
 	}
-	case CHANNEL_12:{
-		handlerADCPin.pGPIOx                    = GPIOC;
-		handlerADCPin.pinConfig.GPIO_PinMode    = GPIO_MODE_ANALOG;
-		handlerADCPin.pinConfig.GPIO_PinNumber  = PIN_2;
-		gpio_Config(&handlerADCPin);
-		break;
+	if(handlerADCDma.config.interruptHalf == DMA_INT_ENABLE){
+		adc_config_dma(DMA_INT_DISABLE);
 	}
-	case CHANNEL_13:{
-		handlerADCPin.pGPIOx                    = GPIOC;
-		handlerADCPin.pinConfig.GPIO_PinMode    = GPIO_MODE_ANALOG;
-		handlerADCPin.pinConfig.GPIO_PinNumber  = PIN_3;
-		gpio_Config(&handlerADCPin);
-		break;
+
+	adcScanSamples = pSamples;
+
+	/* El stream es circular: al terminar la secuencia vuelve al inicio del arreglo */
+	adc_start_dma_requests(pSamples, adcScanLength, scanMode);
+}
+
+/*
+ * Detiene el modo scan. La secuencia en curso se termina, pero el DMA ya no la copia.
+ */
+void adc_StopScan(void){
+
+	ADC1->CR2 &= ~ADC_CR2_CONT;
+
+	dma_StopTransfer(&handlerADCDma);
+
+	ADC1->CR2 &= ~(ADC_CR2_DMA | ADC_CR2_DDS);
+}
+
+/*
+ * Registra la función que se llama al terminar cada secuencia, junto con un puntero
+ * de contexto. Con callback = 0 se vuelve a llamar la función adc_ScanCompleteCallback().
+ */
+void adc_RegisterScanCallback(ADC_ScanCallback_t callback, void *pContext){
+
+	__disable_irq();
+	adcScanCallback        = callback;
+	adcScanCallbackContext = pContext;
+	__enable_irq();
+}
+
+__attribute__ ((weak)) void adc_ScanCompleteCallback(void){
+	__NOP();
+}
+
+/*
+ * Tiempo de muestreo de un canal: 3 bits por canal, los canales 0 - 9 en el SMPR2
+ * y los canales 10 - 18 en el SMPR1
+ */
+static void adc_set_channel_sampling(uint8_t channel, uint8_t samplingPeriod){
+
+	uint32_t auxShift = 0;
+
+	if(channel < 10){
+		auxShift = 3 * channel;
+		ADC1->SMPR2 &= ~(0b111UL << auxShift);
+		ADC1->SMPR2 |= ((uint32_t)(samplingPeriod & 0b111) << auxShift);
 	}
-	case CHANNEL_14:{
-		handlerADCPin.pGPIOx                    = GPIOC;
-		handlerADCPin.pinConfig.GPIO_PinMode    = GPIO_MODE_ANALOG;
-		handlerADCPin.pinConfig.GPIO_PinNumber  = PIN_4;
-		gpio_Config(&handlerADCPin);
-		break;
+	else{
+		auxShift = 3 * (channel - 10);
+		ADC1->SMPR1 &= ~(0b111UL << auxShift);
+		ADC1->SMPR1 |= ((uint32_t)(samplingPeriod & 0b111) << auxShift);
 	}
-	case CHANNEL_15:{
-		handlerADCPin.pGPIOx                    = GPIOC;
-		handlerADCPin.pinConfig.GPIO_PinMode    = GPIO_MODE_ANALOG;
-		handlerADCPin.pinConfig.GPIO_PinNumber  = PIN_5;
-		gpio_Config(&handlerADCPin);
-		break;
+}
+
+/*
+ * Carga el canal en la posición rank (0 - 15) de la secuencia regular: 5 bits por
+ * posición, las posiciones 1 - 6 en el SQR3, 7 - 12 en el SQR2 y 13 - 16 en el SQR1
+ */
+static void adc_set_sequence_rank(uint8_t rank, uint8_t channel){
+
+	uint32_t auxChannel = (uint32_t)(channel & 0x1F);
+
+	if(rank < 6){
+		ADC1->SQR3 &= ~(0x1FUL << (5 * rank));
+		ADC1->SQR3 |= (auxChannel << (5 * rank));
 	}
-	default:{
-		break;
+	else if(rank < 12){
+		ADC1->SQR2 &= ~(0x1FUL << (5 * (rank - 6)));
+		ADC1->SQR2 |= (auxChannel << (5 * (rank - 6)));
 	}
+	else{
+		ADC1->SQR1 &= ~(0x1FUL << (5 * (rank - 12)));
+		ADC1->SQR1 |= (auxChannel << (5 * (rank - 12)));
 	}
 }
 
+/*
+ * ADC1 está conectado al DMA2 Stream0, canal 0 (tabla 28 del manual).
+ * Half-word a half-word, la dirección del DR fija y la del arreglo incrementando.
+ * La interrupción de medio bloque solo se usa en el streaming con doble buffer.
+ */
+static void adc_config_dma(uint8_t halfInterrupt){
+
+	handlerADCDma.pStream                  = DMA2_Stream0;
+	handlerADCDma.config.channel           = DMA_CHANNEL_0;
+	handlerADCDma.config.direction         = DMA_DIR_PERIPH_TO_MEM;
+	handlerADCDma.config.periphDataSize    = DMA_DATASIZE_16BIT;
+	handlerADCDma.config.memDataSize       = DMA_DATASIZE_16BIT;
+	handlerADCDma.config.periphIncrement   = DMA_INCREMENT_DISABLE;
+	handlerADCDma.config.memIncrement      = DMA_INCREMENT_ENABLE;
+	handlerADCDma.config.mode              = DMA_MODE_CIRCULAR;
+	handlerADCDma.config.priority          = DMA_PRIORITY_HIGH;
+	handlerADCDma.config.interruptHalf     = halfInterrupt;
+	handlerADCDma.config.interruptComplete = DMA_INT_ENABLE;
+
+	dma_Config(&handlerADCDma);
+}
+
+/*
+ * Carga el DMA con el arreglo y conecta las peticiones del ADC.
+ * Con ADC_SCAN_CONTINUOUS el ADC convierte sin parar (CONT); con trigger externo
+ * cada evento del timer convierte una secuencia y no se usa SWSTART.
+ */
+static void adc_start_dma_requests(uint16_t *pBuffer, uint16_t numberOfData, uint8_t scanMode){
+
+	/* Bajamos DMA para reiniciar las peticiones del ADC (también después de un overrun) */
+	ADC1->CR2 &= ~(ADC_CR2_DMA | ADC_CR2_DDS);
+	ADC1->SR  &= ~ADC_SR_OVR;
 
-/*Configuración para hacer conversiones en multiples canales y en un orden específico*/
+	dma_StartTransfer(&handlerADCDma, (uint32_t)&ADC1->DR, (uint32_t)pBuffer, 0, numberOfData);
 
-/* Configuración para trigger externo */
+	/* DDS mantiene las peticiones al DMA después de la última transferencia */
+	ADC1->CR2 |= ADC_CR2_DMA | ADC_CR2_DDS;
+
+	if(scanMode == ADC_SCAN_CONTINUOUS){
+		ADC1->CR2 |= ADC_CR2_CONT;
+	}
+	else{
+		ADC1->CR2 &= ~ADC_CR2_CONT;
+	}
+
+	if(ADC1->CR2 & ADC_CR2_EXTEN){
+		ADC1->CR2 &= ~ADC_CR2_CONT;
+	}
+	else{
+		//Se inicializa la conversión
+		ADC1->CR2 |= ADC_CR2_SWSTART;
+	}
+}
+
+/*
+ * ISR del DMA2 Stream0: se completó una secuencia del modo scan, o medio buffer
+ * del streaming.
+ * En modo continuo el DMA sigue escribiendo el arreglo mientras se ejecuta el
+ * callback, por lo que este debe copiar o procesar los datos rápidamente.
+ */
+void DMA2_Stream0_IRQHandler(void){
+
+	uint8_t auxFlags = dma_ReadFlags(DMA2_Stream0);
+
+	/* Bajamos las banderas que se leyeron */
+	dma_ClearFlags(DMA2_Stream0, auxFlags);
+
+	/* Streaming: HT publica el bloque A y TC el bloque B */
+	if(ptrADCStream != 0){
+		if(auxFlags & DMA_FLAG_HTIF){
+			adc_stream_publish(ptrADCStream->pBuffer);
+		}
+		if(auxFlags & DMA_FLAG_TCIF){
+			adc_stream_publish(ptrADCStream->pBuffer + ptrADCStream->blockLength);
+		}
+		return;
+	}
+
+	if((auxFlags & DMA_FLAG_TCIF) && (adcScanSamples != 0)){
+
+		if(adcScanCallback != 0){
+			adcScanCallback(adcScanCallbackContext, adcScanSamples, adcScanLength);
+		}
+		else{
+			adc_ScanCompleteCallback();
+		}
+	}
+}
+
+/* Streaming continuo con doble buffer */
+
+/*
+ * Inicia el streaming sobre el canal (adc_ConfigSingleChannel) o la secuencia
+ * (adc_ConfigMultiChannel) configurada. Sin trigger externo el ADC convierte en modo
+ * continuo; con adc_ConfigTrigger/adc_ConfigTimerTrigger la tasa la fija el timer.
+ * Cada bloque terminado se entrega con adc_StreamGetBlock() y se devuelve con
+ * adc_StreamReleaseBlock(): el procesamiento de un bloque debe terminar antes de
+ * que el DMA llene el otro, o se cuenta en blockOverruns.
+ */
+void adc_StartStream(ADC_Stream_t *pStream){
+	adc_start_stream(pStream, 0);
+}
+
+/*
+ * Inicia el streaming. Con pOversampling != 0 cada bloque se convierte en un
+ * resultado del sobremuestreo dentro del ISR, en lugar de entregarse a la aplicación.
+ */
+static void adc_start_stream(ADC_Stream_t *pStream, ADC_Oversampling_t *pOversampling){
+
+	if((pStream == 0) || (pStream->pBuffer == 0) || (pStream->blockLength == 0)){
+		return;
+	}
+
+	pStream->pReadyBlock     = 0;
+	pStream->blockPending    = 0;
+	pStream->blocksCompleted = 0;
+	pStream->blockOverruns   = 0;
+	pStream->adcOverruns     = 0;
+
+	__disable_irq();
+
+	adcScanSamples     = 0;
+	ptrADCStream       = pStream;
+	ptrADCOversampling = pOversampling;
+
+	/* 1. DMA circular sobre los dos bloques, con interrupción de medio bloque */
+	adc_config_dma(DMA_INT_ENABLE);
+
+	/* 2. Sin interrupción por conversión; solo la de overrun del ADC */
+	ADC1->CR1 &= ~ADC_CR1_EOCIE;
+	ADC1->CR1 |= ADC_CR1_OVRIE;
+	NVIC_EnableIRQ(ADC_IRQn);
+
+	__enable_irq();
+
+	/* 3. Arrancamos las conversiones */
+	adc_start_dma_requests(pStream->pBuffer, 2 * pStream->blockLength, ADC_SCAN_CONTINUOUS);
+}
+
+/* Detiene el streaming. Los contadores del ADC_Stream_t se conservan */
+void adc_StopStream(void){
+
+	ADC1->CR2 &= ~ADC_CR2_CONT;
+
+	dma_StopTransfer(&handlerADCDma);
+
+	ADC1->CR2 &= ~(ADC_CR2_DMA | ADC_CR2_DDS);
+	ADC1->CR1 &= ~ADC_CR1_OVRIE;
+
+	/* El watchdog, el grupo inyectado o la interrupción EOC pueden seguir usando el vector del ADC */
+	if(!(ADC1->CR1 & (ADC_CR1_EOCIE | ADC_CR1_AWDIE | ADC_CR1_JEOCIE))){
+		NVIC_DisableIRQ(ADC_IRQn);
+	}
+
+	ptrADCStream       = 0;
+	ptrADCOversampling = 0;
+}
+
+/*
+ * Retorna el bloque (blockLength muestras) que terminó de llenar el DMA, o 0 si
+ * no hay uno nuevo. El bloque le pertenece a la aplicación hasta adc_StreamReleaseBlock().
+ */
+uint16_t *adc_StreamGetBlock(ADC_Stream_t *pStream){
+
+	uint16_t *pBlock = 0;
+
+	__disable_irq();
+	pBlock               = pStream->pReadyBlock;
+	pStream->pReadyBlock = 0;
+	__enable_irq();
+
+	return pBlock;
+}
+
+/* La aplicación terminó de procesar el bloque entregado por adc_StreamGetBlock() */
+void adc_StreamReleaseBlock(ADC_Stream_t *pStream){
+	pStream->blockPending = 0;
+}
+
+/*
+ * Registra la función que recibe cada bloque nuevo del streaming (desde el ISR del DMA).
+ * Con callback = 0 se vuelve a llamar la función adc_StreamBlockCallback().
+ */
+void adc_RegisterStreamCallback(ADC_StreamCallback_t callback, void *pContext){
+
+	__disable_irq();
+	adcStreamCallback        = callback;
+	adcStreamCallbackContext = pContext;
+	__enable_irq();
+}
+
+/* Se llama desde el ISR del DMA cada vez que hay un bloque nuevo */
+__attribute__ ((weak)) void adc_StreamBlockCallback(void){
+	__NOP();
+}
+
+/*
+ * Publica el bloque que acaba de llenar el DMA. Si el anterior no se había liberado,
+ * el DMA ya está escribiendo sobre él: se cuenta como bloque perdido.
+ */
+static void adc_stream_publish(uint16_t *pBlock){
+
+	/* En sobremuestreo el bloque se consume aquí mismo y nunca queda pendiente */
+	if(ptrADCOversampling != 0){
+		ptrADCStream->blocksCompleted++;
+		adc_oversampling_process(pBlock);
+		return;
+	}
+
+	if(ptrADCStream->blockPending){
+		ptrADCStream->blockOverruns++;
+	}
+
+	ptrADCStream->pReadyBlock  = pBlock;
+	ptrADCStream->blockPending = 1;
+	ptrADCStream->blocksCompleted++;
+
+	if(adcStreamCallback != 0){
+		adcStreamCallback(adcStreamCallbackContext, ptrADCStream, pBlock);
+	}
+	else{
+		adc_StreamBlockCallback();
+	}
+}
+
+/* Sobremuestreo */
+
+/*
+ * Inicia el sobremuestreo del canal configurado con adc_ConfigSingleChannel()
+ * (alineación a la derecha). La tasa de resultados es la tasa del ADC (o del trigger)
+ * dividida por 4^n. Se detiene con adc_StopOversampling().
+ */
+void adc_StartOversampling(ADC_Oversampling_t *pOversampling){
+
+	uint8_t auxResolution = 0;
+
+	if(pOversampling->extraBits == 0){
+		pOversampling->extraBits = 1;
+	}
+	if(pOversampling->extraBits > ADC_OVERSAMPLING_MAX_BITS){
+		pOversampling->extraBits = ADC_OVERSAMPLING_MAX_BITS;
+	}
+
+	/* RES = 0b00 ... 0b11 corresponde a 12, 10, 8 y 6 bits */
+	auxResolution = 12 - 2 * ((ADC1->CR1 & ADC_CR1_RES) >> ADC_CR1_RES_Pos);
+
+	pOversampling->resultBits  = auxResolution + pOversampling->extraBits;
+	pOversampling->result      = 0;
+	pOversampling->resultCount = 0;
+
+	/* Cada bloque del doble buffer es un resultado: 4^n = 2^(2n) muestras */
+	pOversampling->stream.pBuffer     = pOversampling->pBuffer;
+	pOversampling->stream.blockLength = (uint16_t)(1U << (2 * pOversampling->extraBits));
+
+	adc_start_stream(&pOversampling->stream, pOversampling);
+}
+
+/**/
+void adc_StopOversampling(void){
+	adc_StopStream();
+}
+
+/*
+ * Registra la función que se llama con cada resultado, junto con un puntero de contexto.
+ * Con callback = 0 se vuelve a llamar la función adc_OversamplingCallback().
+ */
+void adc_RegisterOversamplingCallback(ADC_OversamplingCallback_t callback, void *pContext){
+
+	__disable_irq();
+	adcOversamplingCallback        = callback;
+	adcOversamplingCallbackContext = pContext;
+	__enable_irq();
+}
+
+__attribute__ ((weak)) void adc_OversamplingCallback(void){
+	__NOP();
+}
+
+/*
+ * Suma el bloque y lo desplaza n bits. Sin dithering se redondea al más cercano
+ * (se suma 2^(n-1)); con dithering se suma un valor pseudoaleatorio entre 0 y 2^n - 1,
+ * de forma que el error de redondeo es ruido sin sesgo y desaparece al promediar.
+ */
+static void adc_oversampling_process(uint16_t *pBlock){
+
+	uint32_t auxSum    = 0;
+	uint16_t auxIndex  = 0;
+	uint8_t  auxShift  = ptrADCOversampling->extraBits;
+
+	for(auxIndex = 0; auxIndex < ptrADCStream->blockLength; auxIndex++){
+		auxSum += pBlock[auxIndex];
+	}
+
+	if(ptrADCOversampling->dithering == ADC_DITHER_ON){
+		auxSum += adc_dither_next() & ((1U << auxShift) - 1);
+	}
+	else{
+		auxSum += (1U << (auxShift - 1));
+	}
+
+	/* El redondeo puede pasar del máximo cuando todas las muestras están en el tope */
+	auxSum >>= auxShift;
+	if(auxSum >= (1UL << ptrADCOversampling->resultBits)){
+		auxSum = (1UL << ptrADCOversampling->resultBits) - 1;
+	}
+
+	ptrADCOversampling->result = (uint16_t)auxSum;
+	ptrADCOversampling->resultCount++;
+
+	if(adcOversamplingCallback != 0){
+		adcOversamplingCallback(adcOversamplingCallbackContext, (uint16_t)auxSum);
+	}
+	else{
+		adc_OversamplingCallback();
+	}
+}
+
+/* LFSR de Galois de 16 bits (polinomio 0xB400, periodo 65535) */
+static uint16_t adc_dither_next(void){
+
+	uint16_t auxLsb = adcDitherState & 1;
+
+	adcDitherState >>= 1;
+	if(auxLsb){
+		adcDitherState ^= 0xB400;
+	}
+
+	return adcDitherState;
+}
+
+/* Configuración para trigger externo */
+
+/*
+ * Selecciona qué inicia las conversiones regulares. Se debe llamar después de
+ * adc_ConfigSingleChannel() o adc_ConfigMultiChannel(), pues estas limpian el CR2.
+ * - TRIGGER_AUTO / TRIGGER_MANUAL: por software (SWSTART), triggerSignal no se usa.
+ * - TRIGGER_EXT: con el evento de comparación del canal del PWM (flanco de subida de
+ *   OCxREF), es decir, una conversión (o secuencia) por cada periodo de la señal.
+ * El PWM debe estar configurado con pwm_Config(); no es necesario activar su salida.
+ */
+uint8_t adc_ConfigTrigger(uint8_t sourceType, PWM_Handler_t *triggerSignal){
+
+	uint8_t auxExtSel = ADC_EXTSEL_NONE;
+
+	if(sourceType != TRIGGER_EXT){
+		ADC1->CR2 &= ~(ADC_CR2_EXTEN | ADC_CR2_EXTSEL);
+		return ADC_TRIGGER_OK;
+	}
+
+	auxExtSel = adc_get_cc_trigger_source(triggerSignal->ptrTIMx, triggerSignal->config.channel);
+	if(auxExtSel == ADC_EXTSEL_NONE){
+		return ADC_TRIGGER_UNSUPPORTED;
+	}
+
+	/* El modo continuo ignoraría los eventos después de la primera conversión */
+	adc_StopContinuousConv();
+	adc_set_external_trigger(auxExtSel, TRIGGER_EDGE_RISING);
+
+	return ADC_TRIGGER_OK;
+}
+
+/*
+ * Las conversiones se inician con el update del timer (TRGO), una por cada periodo.
+ * Solo el TIM2 y el TIM3 llevan su TRGO al ADC. El timer debe estar configurado con
+ * timer_Config() y se enciende con timer_SetState().
+ */
+uint8_t adc_ConfigTimerTrigger(Timer_Handler_t *pTimerHandler){
+
+	uint8_t auxExtSel = ADC_EXTSEL_NONE;
+
+	if(pTimerHandler->pTIMx == TIM2){
+		auxExtSel = ADC_EXTSEL_TIM2_TRGO;
+	}
+	else if(pTimerHandler->pTIMx == TIM3){
+		auxExtSel = ADC_EXTSEL_TIM3_TRGO;
+	}
+	else{
+		return ADC_TRIGGER_UNSUPPORTED;
+	}
+
+	adc_set_timer_trgo_update(pTimerHandler->pTIMx);
+
+	adc_StopContinuousConv();
+	adc_set_external_trigger(auxExtSel, TRIGGER_EDGE_RISING);
+
+	return ADC_TRIGGER_OK;
+}
+
+/*
+ * Código EXTSEL del evento de comparación de un canal (PWM_CHANNEL_x) de un timer.
+ * Cada fila es un timer y cada columna un canal.
+ */
+static uint8_t adc_get_cc_trigger_source(TIM_TypeDef *pTIMx, uint8_t pwmChannel){
+
+	static const uint8_t ccTriggerTable[5][4] = {
+		{ADC_EXTSEL_TIM1_CC1, ADC_EXTSEL_TIM1_CC2, ADC_EXTSEL_TIM1_CC3, ADC_EXTSEL_NONE},
+		{ADC_EXTSEL_NONE,     ADC_EXTSEL_TIM2_CC2, ADC_EXTSEL_TIM2_CC3, ADC_EXTSEL_TIM2_CC4},
+		{ADC_EXTSEL_TIM3_CC1, ADC_EXTSEL_NONE,     ADC_EXTSEL_NONE,     ADC_EXTSEL_NONE},
+		{ADC_EXTSEL_NONE,     ADC_EXTSEL_NONE,     ADC_EXTSEL_NONE,     ADC_EXTSEL_TIM4_CC4},
+		{ADC_EXTSEL_TIM5_CC1, ADC_EXTSEL_TIM5_CC2, ADC_EXTSEL_TIM5_CC3, ADC_EXTSEL_NONE}
+	};
+	uint8_t auxRow = 0;
+
+	if(pwmChannel > PWM_CHANNEL_4){
+		return ADC_EXTSEL_NONE;
+	}
+
+	if(pTIMx == TIM1){
+		auxRow = 0;
+	}
+	else if(pTIMx == TIM2){
+		auxRow = 1;
+	}
+	else if(pTIMx == TIM3){
+		auxRow = 2;
+	}
+	else if(pTIMx == TIM4){
+		auxRow = 3;
+	}
+	else if(pTIMx == TIM5){
+		auxRow = 4;
+	}
+	else{
+		return ADC_EXTSEL_NONE;
+	}
+
+	return ccTriggerTable[auxRow][pwmChannel];
+}
+
+/* MMS = 0b010: el evento de update del timer se envía como TRGO */
+static void adc_set_timer_trgo_update(TIM_TypeDef *pTIMx){
+
+	pTIMx->CR2 &= ~TIM_CR2_MMS;
+	pTIMx->CR2 |= TIM_CR2_MMS_1;
+}
+
+/* Carga la fuente (EXTSEL) y el flanco (EXTEN) del trigger de la secuencia regular */
+static void adc_set_external_trigger(uint8_t extSel, uint8_t edge){
+
+	ADC1->CR2 &= ~(ADC_CR2_EXTEN | ADC_CR2_EXTSEL);
+	ADC1->CR2 |= ((uint32_t)(extSel & 0xF) << ADC_CR2_EXTSEL_Pos);
+	ADC1->CR2 |= ((uint32_t)(edge & 0x3) << ADC_CR2_EXTEN_Pos);
+}
+
+/* Grupo inyectado */
+
+/*
+ * Configura el grupo inyectado. Se debe llamar después de adc_ConfigSingleChannel()
+ * o adc_ConfigMultiChannel() (que limpian el CR1 y el CR2), con el ADC ya encendido.
+ * Cada conversión del grupo termina con la interrupción JEOC, que copia los datos en
+ * pGroup->data y llama al callback.
+ */
+void adc_ConfigInjected(ADC_InjectedGroup_t *pGroup){
+
+	uint8_t  auxIndex  = 0;
+	uint8_t  auxLength = pGroup->numberOfChannels;
+	uint32_t auxJsqr   = 0;
+
+	if(auxLength == 0){
+		return;
+	}
+	if(auxLength > ADC_MAX_INJECTED_LENGTH){
+		auxLength = ADC_MAX_INJECTED_LENGTH;
+		pGroup->numberOfChannels = auxLength;
+	}
+
+	/* 1. Pines análogos y tiempo de muestreo de cada canal (compartido con el grupo regular) */
+	for(auxIndex = 0; auxIndex < auxLength; auxIndex++){
+		adc_ConfigAnalogPin(pGroup->channel[auxIndex]);
+		adc_set_channel_sampling(pGroup->channel[auxIndex], pGroup->samplingPeriod[auxIndex]);
+	}
+
+	/* 2. Secuencia: con JL < 3 la conversión comienza en JSQ(4 - JL - 1), es decir,
+	 * los canales se cargan en las últimas posiciones del JSQR */
+	auxJsqr = ((uint32_t)(auxLength - 1) << ADC_JSQR_JL_Pos);
+	for(auxIndex = 0; auxIndex < auxLength; auxIndex++){
+		auxJsqr |= ((uint32_t)(pGroup->channel[auxIndex] & 0x1F) << (5 * (ADC_MAX_INJECTED_LENGTH - auxLength + auxIndex)));
+	}
+	ADC1->JSQR = auxJsqr;
+
+	/* 3. Offsets, JOFRx corresponde al dato JDRx */
+	for(auxIndex = 0; auxIndex < ADC_MAX_INJECTED_LENGTH; auxIndex++){
+		(&ADC1->JOFR1)[auxIndex] = (auxIndex < auxLength) ? (pGroup->offset[auxIndex] & 0xFFF) : 0;
+	}
+
+	/* 4. Con más de un canal el grupo inyectado también necesita el modo scan */
+	if(auxLength > 1){
+		adc_ScanMode(SCAN_ON);
+	}
+
+	/* 5. Trigger del grupo: por software o con un evento de timer (JAUTO debe estar en 0) */
+	ADC1->CR1 &= ~ADC_CR1_JAUTO;
+	ADC1->CR2 &= ~(ADC_CR2_JEXTEN | ADC_CR2_JEXTSEL);
+
+	if(pGroup->triggerSource != ADC_JEXTSEL_SOFTWARE){
+
+		if(pGroup->triggerSource == ADC_JEXTSEL_TIM1_TRGO){
+			adc_set_timer_trgo_update(TIM1);
+		}
+		else if(pGroup->triggerSource == ADC_JEXTSEL_TIM2_TRGO){
+			adc_set_timer_trgo_update(TIM2);
+		}
+		else if(pGroup->triggerSource == ADC_JEXTSEL_TIM4_TRGO){
+			adc_set_timer_trgo_update(TIM4);
+		}
+		else if(pGroup->triggerSource == ADC_JEXTSEL_TIM5_TRGO){
+			adc_set_timer_trgo_update(TIM5);
+		}
+
+		ADC1->CR2 |= ((uint32_t)(pGroup->triggerSource & 0xF) << ADC_CR2_JEXTSEL_Pos);
+		ADC1->CR2 |= ((uint32_t)(pGroup->triggerEdge & 0x3) << ADC_CR2_JEXTEN_Pos);
+	}
+
+	/* 6. Interrupción JEOC y NVIC */
+	__disable_irq();
+
+	ptrADCInjected = pGroup;
+
+	ADC1->SR  &= ~(ADC_SR_JEOC | ADC_SR_JSTRT);
+	ADC1->CR1 |= ADC_CR1_JEOCIE;
+	NVIC_EnableIRQ(ADC_IRQn);
+
+	__enable_irq();
+}
+
+/* Inicia por software la conversión del grupo inyectado */
+void adc_StartInjected(void){
+	ADC1->CR2 |= ADC_CR2_JSWSTART;
+}
+
+/*
+ * Registra la función que se llama al terminar el grupo inyectado, junto con un puntero
+ * de contexto. Con callback = 0 se vuelve a llamar la función adc_InjectedCallback().
+ */
+void adc_RegisterInjectedCallback(ADC_InjectedCallback_t callback, void *pContext){
+
+	__disable_irq();
+	adcInjectedCallback        = callback;
+	adcInjectedCallbackContext = pContext;
+	__enable_irq();
+}
+
+__attribute__ ((weak)) void adc_InjectedCallback(void){
+	__NOP();
+}
+
+/* Watchdog analógico */
+
+/*
+ * Configura el watchdog analógico de las conversiones regulares y lo deja armado.
+ * Se debe llamar después de adc_ConfigSingleChannel() o adc_ConfigMultiChannel(),
+ * pues estas limpian el CR1.
+ */
+void adc_ConfigWatchdog(ADC_WatchdogConfig_t *pWatchdogConfig){
+
+	/* 1. Umbrales de la banda */
+	adc_SetWatchdogThresholds(pWatchdogConfig->lowThreshold, pWatchdogConfig->highThreshold);
+
+	/* 2. Un canal (AWDSGL y AWDCH) o todos los canales de la secuencia */
+	ADC1->CR1 &= ~(ADC_CR1_AWDSGL | ADC_CR1_AWDCH);
+
+	if(pWatchdogConfig->channelMode == ADC_AWD_SINGLE_CHANNEL){
+		ADC1->CR1 |= ADC_CR1_AWDSGL;
+		ADC1->CR1 |= ((uint32_t)(pWatchdogConfig->channel & 0x1F) << ADC_CR1_AWDCH_Pos);
+	}
+
+	/* 3. Activamos el watchdog sobre el grupo regular */
+	ADC1->CR1 |= ADC_CR1_AWDEN;
+
+	/* 4. Interrupción y NVIC */
+	adc_WatchdogOnOFF(ADC_ON);
+}
+
+/*
+ * Cambia la banda del watchdog. Sirve para dar histéresis: después de una excursión
+ * se mueve la banda alrededor del nuevo nivel y se vuelve a armar.
+ */
+void adc_SetWatchdogThresholds(uint16_t lowThreshold, uint16_t highThreshold){
+
+	ADC1->LTR = lowThreshold & ADC_LTR_LT;
+	ADC1->HTR = highThreshold & ADC_HTR_HT;
+}
+
+/*
+ * Arma (ADC_ON) o desarma (ADC_OFF) la interrupción del watchdog. Después de cada
+ * excursión el ISR la desarma, por lo que se debe volver a armar para el siguiente aviso.
+ */
+void adc_WatchdogOnOFF(uint8_t state){
+
+	__disable_irq();
+
+	if(state == ADC_ON){
+
+		/* Una bandera vieja dispararía la interrupción de inmediato */
+		ADC1->SR  &= ~ADC_SR_AWD;
+		ADC1->CR1 |= ADC_CR1_AWDIE;
+		NVIC_EnableIRQ(ADC_IRQn);
+
+	}else{
+
+		ADC1->CR1 &= ~ADC_CR1_AWDIE;
+	}
+
+	__enable_irq();
+}
+
+/*
+ * Registra la función que se llama cuando la señal sale de la banda del watchdog.
+ * Con callback = 0 se vuelve a llamar la función adc_WatchdogCallback().
+ */
+void adc_RegisterWatchdogCallback(ADC_WatchdogCallback_t callback, void *pContext){
+
+	__disable_irq();
+	adcWatchdogCallback        = callback;
+	adcWatchdogCallbackContext = pContext;
+	__enable_irq();
+}
+
+__attribute__ ((weak)) void adc_WatchdogCallback(void){
+	__NOP();
+}
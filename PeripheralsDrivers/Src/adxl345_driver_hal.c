@@ -0,0 +1,208 @@
+/*
+ * adxl345_driver_hal.c
+ *
+ *  Created on: 19/10/2026
+ *      Author: laurasofia
+ */
+
+#include "stm32f4xx.h"
+#include "stm32_assert.h"
+
+#include "adxl345_driver_hal.h"
+
+/* === Headers for private functions === */
+static uint8_t adxl345_write_register(ADXL345_Handler_t *pAdxlHandler, uint8_t regToWrite, uint8_t newValue);
+static uint8_t adxl345_read_registers(ADXL345_Handler_t *pAdxlHandler, uint8_t regToRead, uint8_t *pData, uint8_t numberOfBytes);
+static void adxl345_watermark_callback(void *pContext);
+
+/*
+ * Configuración del sensor:
+ * 1. Se verifica el DEVID
+ * 2. Se detiene la medición mientras se configura (recomendación del datasheet)
+ * 3. Tasa de datos, rango y resolución
+ * 4. FIFO en modo stream con el nivel de watermark
+ * 5. Interrupción de watermark en el pin INT1 o INT2 (activa en alto)
+ * 6. Se activa el modo de medición
+ */
+uint8_t adxl345_Config(ADXL345_Handler_t *pAdxlHandler){
+
+	uint8_t deviceId    = 0;
+	uint8_t dataFormat  = 0;
+	uint8_t intMap      = 0;
+	uint8_t status      = ADXL345_OK;
+
+	/* El watermark debe estar entre 1 y 31 para que la interrupción tenga sentido */
+	if(pAdxlHandler->watermark == 0){
+		pAdxlHandler->watermark = 1;
+	}
+	pAdxlHandler->watermark &= ADXL345_FIFO_SAMPLES_MASK;
+
+	pAdxlHandler->fifoReady    = 0;
+	pAdxlHandler->overrunCount = 0;
+
+	/*1. Verificamos que sea un ADXL345*/
+	if(adxl345_read_registers(pAdxlHandler, ADXL345_REG_DEVID, &deviceId, 1) != ADXL345_OK){
+		return ADXL345_ERROR_BUS;
+	}
+	if(deviceId != ADXL345_DEVID){
+		return ADXL345_ERROR_DEVID;
+	}
+
+	/*2. Modo standby*/
+	status |= adxl345_write_register(pAdxlHandler, ADXL345_REG_POWER_CTL, 0);
+
+	/*3. Tasa de datos y formato (justificado a la derecha, interrupciones activas en alto)*/
+	status |= adxl345_write_register(pAdxlHandler, ADXL345_REG_BW_RATE, pAdxlHandler->dataRate);
+
+	dataFormat = pAdxlHandler->range & 0b11;
+	if(pAdxlHandler->fullResolution){
+		dataFormat |= ADXL345_DATA_FORMAT_FULL_RES;
+	}
+	status |= adxl345_write_register(pAdxlHandler, ADXL345_REG_DATA_FORMAT, dataFormat);
+
+	/*4. FIFO en modo stream: guarda las últimas 32 muestras, descartando las más viejas*/
+	status |= adxl345_write_register(pAdxlHandler, ADXL345_REG_FIFO_CTL, ADXL345_FIFO_MODE_STREAM | pAdxlHandler->watermark);
+
+	/*5. Un 1 en INT_MAP envía la interrupción al pin INT2, un 0 al pin INT1*/
+	if(pAdxlHandler->intPin == ADXL345_INT_PIN_2){
+		intMap = ADXL345_INT_WATERMARK;
+	}
+	status |= adxl345_write_register(pAdxlHandler, ADXL345_REG_INT_MAP, intMap);
+	status |= adxl345_write_register(pAdxlHandler, ADXL345_REG_INT_ENABLE, ADXL345_INT_WATERMARK);
+
+	/*6. Comenzamos a medir*/
+	status |= adxl345_write_register(pAdxlHandler, ADXL345_REG_POWER_CTL, ADXL345_POWER_CTL_MEASURE);
+
+	return (status == ADXL345_OK) ? ADXL345_OK : ADXL345_ERROR_BUS;
+}
+
+/*
+ * Configura la línea EXTI del pin del MCU conectado a INT1/INT2 del sensor.
+ * El pin debe venir en pExtiConfig como entrada; el flanco se fuerza a subida.
+ */
+void adxl345_ConfigInterrupt(ADXL345_Handler_t *pAdxlHandler, EXTI_Config_t *pExtiConfig){
+
+	pExtiConfig->edgeType = EXTERNAL_INTERRUPT_RISING_EDGE;
+
+	exti_RegisterCallback(pExtiConfig, adxl345_watermark_callback, pAdxlHandler);
+	exti_Config(pExtiConfig);
+
+	/* Si la FIFO ya alcanzó el watermark antes de configurar la EXTI, el pin está en alto
+	 * y no habrá flanco hasta vaciarla */
+	if(gpio_ReadPin(pExtiConfig->pGPIOHandler)){
+		pAdxlHandler->fifoReady = 1;
+	}
+}
+
+/*
+ * Retorna 1 (y baja la bandera) si el sensor avisó que la FIFO llegó al watermark
+ */
+uint8_t adxl345_FifoReady(ADXL345_Handler_t *pAdxlHandler){
+
+	if(pAdxlHandler->fifoReady){
+		pAdxlHandler->fifoReady = 0;
+		return 1;
+	}
+	return 0;
+}
+
+/*
+ * Vacía la FIFO del sensor en pSamples (máximo maxSamples muestras).
+ * Retorna el número de muestras leídas.
+ *
+ * La interrupción WATERMARK es por nivel: solo baja cuando las entradas quedan por
+ * debajo del watermark. Si no se vacía la FIFO el pin se queda en alto y no vuelve a
+ * haber flanco, por lo que se recomienda un buffer de ADXL345_FIFO_SIZE muestras.
+ * Mientras se lee pueden llegar muestras nuevas, así que se vuelve a consultar
+ * FIFO_STATUS hasta que quede vacía o se llene el buffer.
+ */
+uint8_t adxl345_ReadFifo(ADXL345_Handler_t *pAdxlHandler, ADXL345_Sample_t *pSamples, uint8_t maxSamples){
+
+	uint8_t samplesRead = 0;
+	uint8_t fifoEntries = 0;
+	uint8_t intSource   = 0;
+
+	/* OVERRUN se levanta aunque no esté habilitada su interrupción */
+	if(adxl345_read_registers(pAdxlHandler, ADXL345_REG_INT_SOURCE, &intSource, 1) != ADXL345_OK){
+		return 0;
+	}
+	if(intSource & ADXL345_INT_OVERRUN){
+		pAdxlHandler->overrunCount++;
+	}
+
+	while(samplesRead < maxSamples){
+
+		if(adxl345_read_registers(pAdxlHandler, ADXL345_REG_FIFO_STATUS, &fifoEntries, 1) != ADXL345_OK){
+			break;
+		}
+		fifoEntries &= ADXL345_FIFO_ENTRIES_MASK;
+
+		if(fifoEntries == 0){
+			break;
+		}
+
+		/* Cada lectura de 6 bytes saca una entrada de la FIFO */
+		while((fifoEntries > 0) && (samplesRead < maxSamples)){
+			if(adxl345_ReadSample(pAdxlHandler, &pSamples[samplesRead]) != ADXL345_OK){
+				return samplesRead;
+			}
+			samplesRead++;
+			fifoEntries--;
+		}
+	}
+
+	return samplesRead;
+}
+
+/*
+ * Lee una muestra (DATAX0 ... DATAZ1) en una sola transacción.
+ * Con la FIFO activa es la entrada más vieja.
+ */
+uint8_t adxl345_ReadSample(ADXL345_Handler_t *pAdxlHandler, ADXL345_Sample_t *pSample){
+
+	uint8_t rawData[6] = {0};
+
+	if(adxl345_read_registers(pAdxlHandler, ADXL345_REG_DATAX0, rawData, 6) != ADXL345_OK){
+		return ADXL345_ERROR_BUS;
+	}
+
+	/* Cada eje llega primero con el byte bajo */
+	pSample->x = (int16_t)((rawData[1] << 8) | rawData[0]);
+	pSample->y = (int16_t)((rawData[3] << 8) | rawData[2]);
+	pSample->z = (int16_t)((rawData[5] << 8) | rawData[4]);
+
+	return ADXL345_OK;
+}
+
+/*
+ * El handler I2C puede ser compartido con otros sensores del bus, por lo que la
+ * dirección del esclavo se carga antes de cada transacción.
+ */
+static uint8_t adxl345_write_register(ADXL345_Handler_t *pAdxlHandler, uint8_t regToWrite, uint8_t newValue){
+
+	pAdxlHandler->pI2CHandler->slaveAddress = pAdxlHandler->address;
+
+	if(i2c_WriteSingleRegister(pAdxlHandler->pI2CHandler, regToWrite, newValue) != eI2C_STATUS_OK){
+		return ADXL345_ERROR_BUS;
+	}
+	return ADXL345_OK;
+}
+
+/**/
+static uint8_t adxl345_read_registers(ADXL345_Handler_t *pAdxlHandler, uint8_t regToRead, uint8_t *pData, uint8_t numberOfBytes){
+
+	pAdxlHandler->pI2CHandler->slaveAddress = pAdxlHandler->address;
+
+	if(i2c_ReadManyRegisters(pAdxlHandler->pI2CHandler, regToRead, pData, numberOfBytes) != eI2C_STATUS_OK){
+		return ADXL345_ERROR_BUS;
+	}
+	return ADXL345_OK;
+}
+
+/* Se ejecuta en el ISR de la línea EXTI: solo avisa al programa principal */
+static void adxl345_watermark_callback(void *pContext){
+
+	ADXL345_Handler_t *pAdxlHandler = (ADXL345_Handler_t *)pContext;
+
+	pAdxlHandler->fifoReady = 1;
+}
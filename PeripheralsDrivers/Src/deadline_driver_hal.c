@@ -0,0 +1,72 @@
+/*
+ * deadline_driver_hal.c
+ *
+ *  Created on: 19/10/2026
+ *      Author: laurasofia
+ */
+
+#include "stm32f4xx.h"
+#include "stm32_assert.h"
+
+#include "deadline_driver_hal.h"
+#include "rcc_driver_hal.h"
+
+/* === Headers for private functions === */
+static void deadline_enable_cycle_counter(void);
+
+/*
+ * Inicia una espera de timeoutUs microsegundos a partir de este instante.
+ * El contador de ciclos se activa la primera vez que se utiliza.
+ */
+Deadline_t deadline_Start(uint32_t timeoutUs){
+
+	Deadline_t deadline = {0};
+
+	deadline_enable_cycle_counter();
+
+	deadline.startCycle    = DWT->CYCCNT;
+	deadline.timeoutCycles = (rcc_GetHclk() / 1000000) * timeoutUs;
+
+	return deadline;
+}
+
+/* Retorna 1 si ya pasó el tiempo de la espera */
+uint8_t deadline_Expired(Deadline_t *pDeadline){
+	return ((DWT->CYCCNT - pDeadline->startCycle) >= pDeadline->timeoutCycles);
+}
+
+/* Retardo activo de delayUs microsegundos (para generar señales por GPIO) */
+void deadline_DelayUs(uint32_t delayUs){
+
+	Deadline_t deadline = deadline_Start(delayUs);
+
+	while(!deadline_Expired(&deadline)){
+		__NOP();
+	}
+}
+
+/* Valor actual del contador de ciclos, para medir duraciones (latencias, tiempos de ejecución) */
+uint32_t deadline_GetCycles(void){
+
+	deadline_enable_cycle_counter();
+
+	return DWT->CYCCNT;
+}
+
+/* Convierte una diferencia de ciclos del HCLK a microsegundos */
+uint32_t deadline_CyclesToUs(uint32_t cycles){
+	return cycles / (rcc_GetHclk() / 1000000);
+}
+
+/*
+ * El DWT pertenece al bloque de depuración: se habilita con TRCENA en el DEMCR
+ * y luego se enciende el contador con CYCCNTENA.
+ */
+static void deadline_enable_cycle_counter(void){
+
+	if(!(DWT->CTRL & DWT_CTRL_CYCCNTENA_Msk)){
+		CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+		DWT->CYCCNT = 0;
+		DWT->CTRL  |= DWT_CTRL_CYCCNTENA_Msk;
+	}
+}
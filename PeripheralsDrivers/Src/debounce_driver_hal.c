@@ -0,0 +1,235 @@
+/*
+ * debounce_driver_hal.c
+ *
+ *  Created on: 19/10/2026
+ *      Author: laurasofia
+ */
+
+#include "stm32f4xx.h"
+#include "stm32_assert.h"
+
+#include "debounce_driver_hal.h"
+
+/* Estado interno de cada puerto registrado */
+typedef struct
+{
+	GPIO_TypeDef   *pGPIOx;
+	uint16_t       pinMask;
+	uint16_t       activeLowMask;
+	uint16_t       state;           //Estado filtrado (1 = presionado)
+	uint16_t       count0;          //Bit 0 del contador vertical
+	uint16_t       count1;          //Bit 1 del contador vertical
+	uint16_t       holdNotified;    //Pines a los que ya se les envió el evento hold
+	uint16_t       holdCounter[16]; //Ticks que lleva presionado cada pin
+} Debounce_Port_t;
+
+/* Variables que necesita internamente el driver */
+static Debounce_Port_t            debouncePorts[DEBOUNCE_MAX_PORTS];
+static uint8_t                    debouncePortCount = 0;
+static uint16_t                   debounceHoldTicks = 0;
+static Debounce_Event_t           debounceQueue[DEBOUNCE_QUEUE_SIZE];
+static volatile uint8_t           debounceQueueHead = 0;   //Escrito solo por el ISR del timer
+static volatile uint8_t           debounceQueueTail = 0;   //Escrito solo por el main
+static volatile uint16_t          debounceDropped   = 0;
+
+/* === Headers for private functions === */
+static void debounce_push_events(uint8_t portIndex, uint16_t pinsMask, uint8_t eventType);
+static void debounce_update_hold(uint8_t portIndex);
+
+/*
+ * Inicia el módulo. holdTicks es el número de ticks de debounce_Sample() que un pin
+ * debe permanecer presionado para generar el evento HOLD (0 desactiva el evento).
+ */
+void debounce_Init(uint16_t holdTicks){
+
+	debouncePortCount = 0;
+	debounceHoldTicks = holdTicks;
+	debounceQueueHead = 0;
+	debounceQueueTail = 0;
+	debounceDropped   = 0;
+}
+
+/*
+ * Registra un puerto. El estado inicial se toma de la lectura actual para no generar
+ * eventos falsos al arrancar. Retorna el índice del puerto, ó 0xFF si no hay espacio.
+ */
+uint8_t debounce_AddPort(Debounce_PortConfig_t *pPortConfig){
+
+	Debounce_Port_t *pPort = 0;
+	uint8_t pinIndex = 0;
+
+	if(debouncePortCount >= DEBOUNCE_MAX_PORTS){
+		return 0xFF;
+	}
+
+	pPort = &debouncePorts[debouncePortCount];
+
+	pPort->pGPIOx         = pPortConfig->pGPIOx;
+	pPort->pinMask        = pPortConfig->pinMask;
+	pPort->activeLowMask  = pPortConfig->activeLowMask;
+	pPort->state          = ((uint16_t)pPort->pGPIOx->IDR ^ pPort->activeLowMask) & pPort->pinMask;
+	pPort->count0         = 0xFFFF;
+	pPort->count1         = 0xFFFF;
+	pPort->holdNotified   = 0;
+
+	for(pinIndex = 0; pinIndex < 16; pinIndex++){
+		pPort->holdCounter[pinIndex] = 0;
+	}
+
+	/* El ISR del timer puede estar corriendo, el puerto se publica al final */
+	__disable_irq();
+	debouncePortCount++;
+	__enable_irq();
+
+	return debouncePortCount - 1;
+}
+
+/*
+ * Debe ser llamada periódicamente desde el callback de un timer.
+ *
+ * Contador vertical: count1:count0 forman un contador de 2 bits por pin que se reinicia
+ * (en 0b11) mientras la muestra coincide con el estado, y cuenta hacia abajo mientras
+ * difiere. Cuando da la vuelta (4 muestras seguidas diferentes) el pin cambia de estado.
+ */
+void debounce_Sample(void){
+
+	Debounce_Port_t *pPort = 0;
+	uint16_t sample  = 0;
+	uint16_t changed = 0;
+	uint8_t  portIndex = 0;
+
+	for(portIndex = 0; portIndex < debouncePortCount; portIndex++){
+
+		pPort = &debouncePorts[portIndex];
+
+		/* 1. Muestra en lógica positiva (1 = presionado) */
+		sample = ((uint16_t)pPort->pGPIOx->IDR ^ pPort->activeLowMask) & pPort->pinMask;
+
+		/* 2. Pines cuya muestra es diferente del estado filtrado */
+		changed = pPort->state ^ sample;
+
+		/* 3. Contamos (o reiniciamos) los 16 contadores a la vez */
+		pPort->count0 = ~(pPort->count0 & changed);
+		pPort->count1 = pPort->count0 ^ (pPort->count1 & changed);
+
+		/* 4. Pines cuyo contador dio la vuelta */
+		changed &= pPort->count0 & pPort->count1;
+		pPort->state ^= changed;
+
+		/* 5. Eventos */
+		if(changed){
+			debounce_push_events(portIndex, changed & pPort->state, DEBOUNCE_EVENT_PRESS);
+			debounce_push_events(portIndex, changed & ~pPort->state, DEBOUNCE_EVENT_RELEASE);
+		}
+
+		if(debounceHoldTicks != 0){
+			debounce_update_hold(portIndex);
+		}
+	}
+}
+
+/*
+ * Toma el evento más antiguo de la cola. Retorna 1 si había un evento, 0 si la cola está vacía.
+ */
+uint8_t debounce_GetEvent(Debounce_Event_t *pEvent){
+
+	uint8_t auxTail = debounceQueueTail;
+
+	if(auxTail == debounceQueueHead){
+		return 0;
+	}
+
+	*pEvent = debounceQueue[auxTail];
+	debounceQueueTail = (auxTail + 1) & (DEBOUNCE_QUEUE_SIZE - 1);
+
+	return 1;
+}
+
+/* Estado filtrado de los pines de un puerto (1 = presionado) */
+uint16_t debounce_GetState(uint8_t portIndex){
+
+	if(portIndex >= debouncePortCount){
+		return 0;
+	}
+
+	return debouncePorts[portIndex].state;
+}
+
+/* Número de eventos que se perdieron porque la cola estaba llena */
+uint16_t debounce_GetDroppedEvents(void){
+	return debounceDropped;
+}
+
+/*
+ * Agrega a la cola un evento por cada pin presente en pinsMask
+ */
+static void debounce_push_events(uint8_t portIndex, uint16_t pinsMask, uint8_t eventType){
+
+	uint8_t auxHead = debounceQueueHead;
+	uint8_t auxNext = 0;
+	uint8_t pinNumber = 0;
+
+	while(pinsMask){
+
+		/* Posición del bit menos significativo en 1 */
+		pinNumber = __CLZ(__RBIT(pinsMask));
+		pinsMask &= pinsMask - 1;
+
+		auxNext = (auxHead + 1) & (DEBOUNCE_QUEUE_SIZE - 1);
+
+		if(auxNext == debounceQueueTail){
+			debounceDropped++;
+			continue;
+		}
+
+		debounceQueue[auxHead].portIndex = portIndex;
+		debounceQueue[auxHead].pinNumber = pinNumber;
+		debounceQueue[auxHead].eventType = eventType;
+		auxHead = auxNext;
+	}
+
+	debounceQueueHead = auxHead;
+}
+
+/*
+ * Cuenta cuántos ticks lleva presionado cada pin y envía un solo evento HOLD
+ * al llegar a debounceHoldTicks. Solo se recorren los pines presionados.
+ */
+static void debounce_update_hold(uint8_t portIndex){
+
+	Debounce_Port_t *pPort = &debouncePorts[portIndex];
+	uint16_t pressed = pPort->state;
+	uint16_t reached = 0;
+	uint8_t pinNumber = 0;
+
+	/* Los pines que se soltaron vuelven a poder generar HOLD */
+	pPort->holdNotified &= pressed;
+
+	pressed &= ~pPort->holdNotified;
+
+	while(pressed){
+
+		pinNumber = __CLZ(__RBIT(pressed));
+		pressed &= pressed - 1;
+
+		if(pPort->holdCounter[pinNumber] < debounceHoldTicks){
+			pPort->holdCounter[pinNumber]++;
+		}
+		if(pPort->holdCounter[pinNumber] >= debounceHoldTicks){
+			reached |= (1U << pinNumber);
+		}
+	}
+
+	/* Reiniciamos los contadores de los pines que no están presionados */
+	pressed = pPort->pinMask & ~pPort->state;
+	while(pressed){
+		pinNumber = __CLZ(__RBIT(pressed));
+		pressed &= pressed - 1;
+		pPort->holdCounter[pinNumber] = 0;
+	}
+
+	if(reached){
+		pPort->holdNotified |= reached;
+		debounce_push_events(portIndex, reached, DEBOUNCE_EVENT_HOLD);
+	}
+}
@@ -0,0 +1,237 @@
+/*
+ * dma_driver_hal.c
+ *
+ *  Created on: 19/10/2026
+ *      Author: laurasofia
+ */
+
+#include "stm32f4xx.h"
+#include "stm32_assert.h"
+
+#include "dma_driver_hal.h"
+#include "deadline_driver_hal.h"
+
+/* Vector de interrupción de cada stream (DMA1 0..7, DMA2 0..7) */
+static const IRQn_Type dmaStreamIRQn[16] = {
+		DMA1_Stream0_IRQn, DMA1_Stream1_IRQn, DMA1_Stream2_IRQn, DMA1_Stream3_IRQn,
+		DMA1_Stream4_IRQn, DMA1_Stream5_IRQn, DMA1_Stream6_IRQn, DMA1_Stream7_IRQn,
+		DMA2_Stream0_IRQn, DMA2_Stream1_IRQn, DMA2_Stream2_IRQn, DMA2_Stream3_IRQn,
+		DMA2_Stream4_IRQn, DMA2_Stream5_IRQn, DMA2_Stream6_IRQn, DMA2_Stream7_IRQn
+};
+
+/* Posición de las banderas de cada stream dentro de LISR/HISR (la misma para 0-3 y 4-7) */
+static const uint8_t dmaFlagShift[4] = {0, 6, 16, 22};
+
+/* === Headers for private functions === */
+static DMA_TypeDef *dma_get_controller(DMA_Stream_TypeDef *pStream);
+static uint8_t dma_get_stream_number(DMA_Stream_TypeDef *pStream);
+static void dma_enable_clock_peripheral(DMA_Handler_t *pDMAHandler);
+static void dma_config_interrupt(DMA_Handler_t *pDMAHandler);
+
+/*
+ * Configura el stream seleccionado. El stream queda apagado (EN = 0), listo para
+ * que se le carguen las direcciones con dma_StartTransfer().
+ * Todo el registro CR se calcula primero en una variable auxiliar y se escribe una sola vez.
+ */
+void dma_Config(DMA_Handler_t *pDMAHandler){
+
+	uint32_t auxConfig = 0;
+
+	/* 1. Activamos la señal de reloj del controlador DMA */
+	dma_enable_clock_peripheral(pDMAHandler);
+
+	/* 2. El stream debe estar apagado para poder configurarlo */
+	dma_StopTransfer(pDMAHandler);
+
+	/* 3. Canal, dirección, tamaños de dato, incrementos y prioridad */
+	auxConfig |= ((uint32_t)pDMAHandler->config.channel << DMA_SxCR_CHSEL_Pos);
+	auxConfig |= ((uint32_t)pDMAHandler->config.direction << DMA_SxCR_DIR_Pos);
+	auxConfig |= ((uint32_t)pDMAHandler->config.periphDataSize << DMA_SxCR_PSIZE_Pos);
+	auxConfig |= ((uint32_t)pDMAHandler->config.memDataSize << DMA_SxCR_MSIZE_Pos);
+	auxConfig |= ((uint32_t)pDMAHandler->config.priority << DMA_SxCR_PL_Pos);
+
+	if(pDMAHandler->config.periphIncrement == DMA_INCREMENT_ENABLE){
+		auxConfig |= DMA_SxCR_PINC;
+	}
+	if(pDMAHandler->config.memIncrement == DMA_INCREMENT_ENABLE){
+		auxConfig |= DMA_SxCR_MINC;
+	}
+
+	/* 4. Modo de funcionamiento. El doble buffer implica el modo circular */
+	if(pDMAHandler->config.mode == DMA_MODE_CIRCULAR){
+		auxConfig |= DMA_SxCR_CIRC;
+	}
+	else if(pDMAHandler->config.mode == DMA_MODE_DOUBLE_BUFFER){
+		auxConfig |= DMA_SxCR_CIRC | DMA_SxCR_DBM;
+	}
+
+	/* 5. Interrupciones del stream */
+	if(pDMAHandler->config.interruptHalf == DMA_INT_ENABLE){
+		auxConfig |= DMA_SxCR_HTIE;
+	}
+	if(pDMAHandler->config.interruptComplete == DMA_INT_ENABLE){
+		auxConfig |= DMA_SxCR_TCIE | DMA_SxCR_TEIE;
+	}
+
+	pDMAHandler->pStream->CR = auxConfig;
+
+	/* 6. Si los tamaños de dato son diferentes se necesita la FIFO (el direct mode
+	 * no permite empaquetar), en caso contrario se trabaja en direct mode */
+	if(pDMAHandler->config.periphDataSize != pDMAHandler->config.memDataSize){
+		pDMAHandler->pStream->FCR = DMA_SxFCR_DMDIS | DMA_SxFCR_FTH;
+	}
+	else{
+		pDMAHandler->pStream->FCR = 0;
+	}
+
+	/* 7. Matriculamos (o removemos) el stream en el NVIC */
+	__disable_irq();
+	dma_config_interrupt(pDMAHandler);
+	__enable_irq();
+}
+
+/*
+ * Carga las direcciones y el número de datos, limpia las banderas viejas y enciende el stream.
+ * memAddress1 solo se utiliza en el modo doble buffer.
+ * En modo Mem -> Mem el "periférico" es la memoria fuente (PAR).
+ */
+void dma_StartTransfer(DMA_Handler_t *pDMAHandler, uint32_t periphAddress, uint32_t memAddress0, uint32_t memAddress1, uint16_t numberOfData){
+
+	/* El stream debe estar apagado para cargar los registros */
+	dma_StopTransfer(pDMAHandler);
+
+	pDMAHandler->pStream->PAR  = periphAddress;
+	pDMAHandler->pStream->M0AR = memAddress0;
+	pDMAHandler->pStream->M1AR = memAddress1;
+	pDMAHandler->pStream->NDTR = numberOfData;
+
+	/* Si quedan banderas levantadas de la transferencia anterior el stream no arranca */
+	dma_ClearFlags(pDMAHandler->pStream, DMA_FLAG_ALL);
+
+	/* Comenzamos siempre por el buffer 0 */
+	pDMAHandler->pStream->CR &= ~DMA_SxCR_CT;
+	pDMAHandler->pStream->CR |= DMA_SxCR_EN;
+}
+
+/*
+ * Apaga el stream y espera a que el hardware termine la transferencia en curso
+ * (EN se lee en 1 hasta que el último dato es transferido).
+ * Retorna DMA_STATUS_OK, o DMA_STATUS_TIMEOUT si el stream no se detuvo.
+ */
+uint8_t dma_StopTransfer(DMA_Handler_t *pDMAHandler){
+
+	Deadline_t deadline = {0};
+
+	pDMAHandler->pStream->CR &= ~DMA_SxCR_EN;
+
+	/* Si el periférico dejó de pedir datos a mitad de una ráfaga, EN no baja nunca */
+	deadline = deadline_Start(DMA_TIMEOUT_US);
+	while(pDMAHandler->pStream->CR & DMA_SxCR_EN){
+		if(deadline_Expired(&deadline)){
+			return DMA_STATUS_TIMEOUT;
+		}
+	}
+
+	return DMA_STATUS_OK;
+}
+
+/* Número de datos que faltan por transferir en el bloque actual */
+uint16_t dma_GetRemaining(DMA_Handler_t *pDMAHandler){
+	return (uint16_t)pDMAHandler->pStream->NDTR;
+}
+
+/* En modo doble buffer indica qué buffer está usando el DMA en este momento (0 ó 1) */
+uint8_t dma_GetCurrentTarget(DMA_Handler_t *pDMAHandler){
+	return (pDMAHandler->pStream->CR & DMA_SxCR_CT) ? 1 : 0;
+}
+
+/*
+ * Retorna las banderas del stream desplazadas a la posición del stream 0,
+ * de forma que se pueden comparar con DMA_FLAG_xxx sin importar el stream.
+ */
+uint8_t dma_ReadFlags(DMA_Stream_TypeDef *pStream){
+
+	DMA_TypeDef *pDMAx   = dma_get_controller(pStream);
+	uint8_t streamNumber = dma_get_stream_number(pStream);
+	uint32_t auxFlags    = 0;
+
+	if(streamNumber < 4){
+		auxFlags = pDMAx->LISR;
+	}
+	else{
+		auxFlags = pDMAx->HISR;
+	}
+
+	return (uint8_t)((auxFlags >> dmaFlagShift[streamNumber & 0x3]) & DMA_FLAG_ALL);
+}
+
+/* Baja las banderas indicadas (formato DMA_FLAG_xxx) del stream */
+void dma_ClearFlags(DMA_Stream_TypeDef *pStream, uint8_t flags){
+
+	DMA_TypeDef *pDMAx   = dma_get_controller(pStream);
+	uint8_t streamNumber = dma_get_stream_number(pStream);
+	uint32_t auxFlags    = ((uint32_t)(flags & DMA_FLAG_ALL) << dmaFlagShift[streamNumber & 0x3]);
+
+	/* LIFCR/HIFCR son "write 1 to clear", no se debe usar |= */
+	if(streamNumber < 4){
+		pDMAx->LIFCR = auxFlags;
+	}
+	else{
+		pDMAx->HIFCR = auxFlags;
+	}
+}
+
+/* Los streams del DMA2 están en posiciones de memoria mayores que las del DMA1 */
+static DMA_TypeDef *dma_get_controller(DMA_Stream_TypeDef *pStream){
+
+	if(pStream >= DMA2_Stream0){
+		return DMA2;
+	}
+	else{
+		return DMA1;
+	}
+}
+
+/* Los 8 streams de cada controlador son consecutivos en memoria */
+static uint8_t dma_get_stream_number(DMA_Stream_TypeDef *pStream){
+
+	if(pStream >= DMA2_Stream0){
+		return (uint8_t)(pStream - DMA2_Stream0);
+	}
+	else{
+		return (uint8_t)(pStream - DMA1_Stream0);
+	}
+}
+
+/*
+ * Activa la señal de reloj del controlador al que pertenece el stream
+ */
+static void dma_enable_clock_peripheral(DMA_Handler_t *pDMAHandler){
+
+	if(dma_get_controller(pDMAHandler->pStream) == DMA1){
+		RCC->AHB1ENR |= RCC_AHB1ENR_DMA1EN;
+	}
+	else{
+		RCC->AHB1ENR |= RCC_AHB1ENR_DMA2EN;
+	}
+}
+
+/*
+ * Matricula el vector del stream en el NVIC si se utiliza alguna interrupción.
+ * El ISR (DMAx_Streamy_IRQHandler) lo define el driver del periférico que usa el stream.
+ */
+static void dma_config_interrupt(DMA_Handler_t *pDMAHandler){
+
+	uint8_t auxIndex = dma_get_stream_number(pDMAHandler->pStream);
+
+	if(dma_get_controller(pDMAHandler->pStream) == DMA2){
+		auxIndex += 8;
+	}
+
+	if((pDMAHandler->config.interruptHalf == DMA_INT_ENABLE) || (pDMAHandler->config.interruptComplete == DMA_INT_ENABLE)){
+		NVIC_EnableIRQ(dmaStreamIRQn[auxIndex]);
+	}
+	else{
+		NVIC_DisableIRQ(dmaStreamIRQn[auxIndex]);
+	}
+}
@@ -0,0 +1,317 @@
+/*
+ * dsp_driver_hal.c
+ *
+ *  Created on: 19/10/2026
+ *      Author: laurasofia
+ */
+
+#ifndef DSP_HOST_TEST
+#include "stm32f4xx.h"
+#endif
+#include "stm32_assert.h"
+
+#include "dsp_driver_hal.h"
+
+/* Las instrucciones DSP (SMLALD, PKHBT, SSAT) solo existen en el Cortex-M4/M7.
+ * Las pruebas en el PC la definen para comparar las dos versiones */
+#ifndef DSP_USE_SIMD
+#if defined(__ARM_FEATURE_DSP) && (__ARM_FEATURE_DSP == 1)
+#define DSP_USE_SIMD    1
+#else
+#define DSP_USE_SIMD    0
+#endif
+#endif
+
+/* === Headers for private functions === */
+static inline q15_t dsp_saturate_q15(int32_t value);
+static inline q15_t dsp_biquad_kernel(DSP_Biquad_t *pFilter, q15_t sample);
+static inline int64_t dsp_biquad_mac_c(DSP_Biquad_t *pFilter, q15_t sample);
+#if DSP_USE_SIMD
+static inline int64_t dsp_biquad_mac_simd(DSP_Biquad_t *pFilter, q15_t sample);
+#endif
+
+/*
+ * Promedio móvil: pHistory debe tener 2^log2Length posiciones.
+ * La ventana comienza llena de ceros, por lo que las primeras salidas suben poco a poco.
+ */
+void dsp_MovingAverageInit(DSP_MovingAverage_t *pFilter, q15_t *pHistory, uint8_t log2Length){
+
+	uint16_t auxIndex = 0;
+
+	/* Con 2^15 muestras de 16 bits la suma todavía cabe en 32 bits */
+	if(log2Length > 15){
+		log2Length = 15;
+	}
+
+	pFilter->pHistory   = pHistory;
+	pFilter->log2Length = log2Length;
+	pFilter->index      = 0;
+	pFilter->sum        = 0;
+
+	for(auxIndex = 0; auxIndex < (1U << log2Length); auxIndex++){
+		pHistory[auxIndex] = 0;
+	}
+}
+
+/* Agrega una muestra y retorna el promedio de la ventana (una suma, una resta y un desplazamiento) */
+q15_t dsp_MovingAverage(DSP_MovingAverage_t *pFilter, q15_t sample){
+
+	pFilter->sum += (q31_t)sample - pFilter->pHistory[pFilter->index];
+	pFilter->pHistory[pFilter->index] = sample;
+
+	/* La ventana es potencia de 2: el índice da la vuelta con una máscara */
+	pFilter->index = (pFilter->index + 1) & ((1U << pFilter->log2Length) - 1);
+
+	return (q15_t)(pFilter->sum >> pFilter->log2Length);
+}
+
+/**/
+void dsp_ExponentialInit(DSP_Exponential_t *pFilter, q15_t alpha, q15_t initialValue){
+
+	if(alpha < 0){
+		alpha = 0;
+	}
+
+	pFilter->alpha = alpha;
+	pFilter->state = (int64_t)initialValue << 16;
+}
+
+/* y += alpha * (x - y), con redondeo al entregar los 16 bits */
+q15_t dsp_Exponential(DSP_Exponential_t *pFilter, q15_t sample){
+
+	int64_t auxDiff = ((int64_t)sample << 16) - pFilter->state;
+
+	pFilter->state += (auxDiff * pFilter->alpha) >> 15;
+
+	return dsp_saturate_q15((int32_t)((pFilter->state + 0x8000) >> 16));
+}
+
+/*
+ * Decimador CIC. Si order * log2Decimation pasa de 16 se reduce la decimación,
+ * para que la ganancia R^N quepa en el acumulador de 32 bits.
+ */
+void dsp_CicInit(DSP_Cic_t *pFilter, uint8_t order, uint8_t log2Decimation){
+
+	uint8_t auxIndex = 0;
+
+	if(order == 0){
+		order = 1;
+	}
+	if(order > DSP_CIC_MAX_ORDER){
+		order = DSP_CIC_MAX_ORDER;
+	}
+	if((order * log2Decimation) > 16){
+		log2Decimation = 16 / order;
+	}
+
+	pFilter->order          = order;
+	pFilter->log2Decimation = log2Decimation;
+	pFilter->counter        = 0;
+
+	for(auxIndex = 0; auxIndex < DSP_CIC_MAX_ORDER; auxIndex++){
+		pFilter->integrator[auxIndex] = 0;
+		pFilter->comb[auxIndex]       = 0;
+	}
+}
+
+/*
+ * Procesa una muestra de entrada. Retorna 1 y entrega en pOutput una muestra
+ * cada 2^log2Decimation entradas; en las demás retorna 0.
+ */
+uint8_t dsp_Cic(DSP_Cic_t *pFilter, q15_t sample, q15_t *pOutput){
+
+	uint8_t  auxIndex = 0;
+	uint32_t auxValue = (uint32_t)(int32_t)sample;
+	uint32_t auxPrev  = 0;
+
+	/* 1. Integradores a la tasa de entrada */
+	for(auxIndex = 0; auxIndex < pFilter->order; auxIndex++){
+		pFilter->integrator[auxIndex] += auxValue;
+		auxValue = pFilter->integrator[auxIndex];
+	}
+
+	pFilter->counter++;
+	if(pFilter->counter < (1U << pFilter->log2Decimation)){
+		return 0;
+	}
+	pFilter->counter = 0;
+
+	/* 2. Peines (retardo de una muestra) a la tasa de salida */
+	for(auxIndex = 0; auxIndex < pFilter->order; auxIndex++){
+		auxPrev                 = auxValue;
+		auxValue               -= pFilter->comb[auxIndex];
+		pFilter->comb[auxIndex] = auxPrev;
+	}
+
+	/* 3. Compensamos la ganancia R^N */
+	*pOutput = dsp_saturate_q15((int32_t)auxValue >> (pFilter->order * pFilter->log2Decimation));
+
+	return 1;
+}
+
+/*
+ * Mediana de length muestras. Un largo par se sube al impar siguiente (o se baja si
+ * pasa del máximo). La ventana comienza llena con initialValue.
+ */
+void dsp_MedianInit(DSP_Median_t *pFilter, uint8_t length, q15_t initialValue){
+
+	uint8_t auxIndex = 0;
+
+	if(length == 0){
+		length = 1;
+	}
+	if((length & 1) == 0){
+		length++;
+	}
+	if(length > DSP_MEDIAN_MAX_LENGTH){
+		length = DSP_MEDIAN_MAX_LENGTH;
+	}
+
+	pFilter->length = length;
+	pFilter->index  = 0;
+
+	for(auxIndex = 0; auxIndex < length; auxIndex++){
+		pFilter->history[auxIndex] = initialValue;
+		pFilter->sorted[auxIndex]  = initialValue;
+	}
+}
+
+/*
+ * La muestra que sale de la ventana se reemplaza por la nueva en el arreglo ordenado,
+ * y la nueva se desplaza a la izquierda o a la derecha hasta su lugar.
+ */
+q15_t dsp_Median(DSP_Median_t *pFilter, q15_t sample){
+
+	q15_t   auxOldest = pFilter->history[pFilter->index];
+	q15_t   auxSwap   = 0;
+	uint8_t auxPos    = 0;
+
+	pFilter->history[pFilter->index] = sample;
+	pFilter->index++;
+	if(pFilter->index >= pFilter->length){
+		pFilter->index = 0;
+	}
+
+	/* 1. Buscamos la muestra más vieja (siempre está en el arreglo ordenado) */
+	while((auxPos < (pFilter->length - 1)) && (pFilter->sorted[auxPos] != auxOldest)){
+		auxPos++;
+	}
+	pFilter->sorted[auxPos] = sample;
+
+	/* 2. Hacia la izquierda si es menor que su vecino */
+	while((auxPos > 0) && (pFilter->sorted[auxPos - 1] > pFilter->sorted[auxPos])){
+		auxSwap                     = pFilter->sorted[auxPos - 1];
+		pFilter->sorted[auxPos - 1] = pFilter->sorted[auxPos];
+		pFilter->sorted[auxPos]     = auxSwap;
+		auxPos--;
+	}
+
+	/* 3. Hacia la derecha si es mayor */
+	while((auxPos < (pFilter->length - 1)) && (pFilter->sorted[auxPos + 1] < pFilter->sorted[auxPos])){
+		auxSwap                     = pFilter->sorted[auxPos + 1];
+		pFilter->sorted[auxPos + 1] = pFilter->sorted[auxPos];
+		pFilter->sorted[auxPos]     = auxSwap;
+		auxPos++;
+	}
+
+	return pFilter->sorted[pFilter->length / 2];
+}
+
+/* Coeficientes en Q14; el estado comienza en cero */
+void dsp_BiquadInit(DSP_Biquad_t *pFilter, q15_t b0, q15_t b1, q15_t b2, q15_t a1, q15_t a2){
+
+	pFilter->b0 = b0;
+	pFilter->b1 = b1;
+	pFilter->b2 = b2;
+	pFilter->a1 = a1;
+	pFilter->a2 = a2;
+
+	pFilter->x1 = 0;
+	pFilter->x2 = 0;
+	pFilter->y1 = 0;
+	pFilter->y2 = 0;
+}
+
+/**/
+q15_t dsp_Biquad(DSP_Biquad_t *pFilter, q15_t sample){
+	return dsp_biquad_kernel(pFilter, sample);
+}
+
+/* Filtra un bloque completo (por ejemplo un bloque del streaming del ADC) */
+void dsp_BiquadBlock(DSP_Biquad_t *pFilter, const q15_t *pInput, q15_t *pOutput, uint16_t numberOfSamples){
+
+	uint16_t auxIndex = 0;
+
+	for(auxIndex = 0; auxIndex < numberOfSamples; auxIndex++){
+		pOutput[auxIndex] = dsp_biquad_kernel(pFilter, pInput[auxIndex]);
+	}
+}
+
+/*
+ * Una muestra del biquad. Los productos Q15 x Q14 se acumulan en 64 bits (cinco
+ * productos pueden pasar de 32 bits) y el resultado vuelve a Q15 con redondeo.
+ */
+static inline q15_t dsp_biquad_kernel(DSP_Biquad_t *pFilter, q15_t sample){
+
+	int64_t auxAcc = 0;
+	q15_t   auxOut = 0;
+
+#if DSP_USE_SIMD
+	auxAcc = dsp_biquad_mac_simd(pFilter, sample);
+#else
+	auxAcc = dsp_biquad_mac_c(pFilter, sample);
+#endif
+
+	auxOut = dsp_saturate_q15((int32_t)((auxAcc + (1 << 13)) >> 14));
+
+	pFilter->x2 = pFilter->x1;
+	pFilter->x1 = sample;
+	pFilter->y2 = pFilter->y1;
+	pFilter->y1 = auxOut;
+
+	return auxOut;
+}
+
+/* Suma de los cinco productos del biquad, un MAC a la vez */
+static inline int64_t dsp_biquad_mac_c(DSP_Biquad_t *pFilter, q15_t sample){
+
+	int64_t auxAcc = 0;
+
+	auxAcc  = (int32_t)pFilter->b0 * sample;
+	auxAcc += (int32_t)pFilter->b1 * pFilter->x1;
+	auxAcc += (int32_t)pFilter->b2 * pFilter->x2;
+	auxAcc += (int32_t)pFilter->a1 * pFilter->y1;
+	auxAcc += (int32_t)pFilter->a2 * pFilter->y2;
+
+	return auxAcc;
+}
+
+#if DSP_USE_SIMD
+/* La misma suma con tres SMLALD sobre pares empaquetados con PKHBT */
+static inline int64_t dsp_biquad_mac_simd(DSP_Biquad_t *pFilter, q15_t sample){
+
+	int64_t auxAcc = 0;
+
+	auxAcc = (int64_t)__SMLALD(__PKHBT(sample, pFilter->x1, 16), __PKHBT(pFilter->b0, pFilter->b1, 16), (uint64_t)auxAcc);
+	auxAcc = (int64_t)__SMLALD(__PKHBT(pFilter->x2, pFilter->y1, 16), __PKHBT(pFilter->b2, pFilter->a1, 16), (uint64_t)auxAcc);
+	auxAcc = (int64_t)__SMLALD((uint16_t)pFilter->y2, (uint16_t)pFilter->a2, (uint64_t)auxAcc);
+
+	return auxAcc;
+}
+#endif
+
+/* Satura un valor de 32 bits al rango Q15 */
+static inline q15_t dsp_saturate_q15(int32_t value){
+
+#if DSP_USE_SIMD
+	return (q15_t)__SSAT(value, 16);
+#else
+	if(value > INT16_MAX){
+		return INT16_MAX;
+	}
+	if(value < INT16_MIN){
+		return INT16_MIN;
+	}
+	return (q15_t)value;
+#endif
+}
@@ -8,10 +8,65 @@
 #include <stdint.h>
 #include  "i2c_driver_hal.h"
 #include  "gpio_driver_hal.h"
+#include  "dma_driver_hal.h"
+#include  "rcc_driver_hal.h"
+#include  "deadline_driver_hal.h"
 
 //GPIO_Handler_t    *sdaPin
 //GPIO_Handler_t    *sclPin
 
+/* Estados de la máquina de transacciones no bloqueantes */
+enum{
+	eI2C_STATE_IDLE = 0,
+	eI2C_STATE_START_WRITE,    //Esperando SB para enviar dirección + W
+	eI2C_STATE_ADDR_WRITE,     //Esperando ADDR
+	eI2C_STATE_SEND_REG,       //Esperando BTF de la dirección del registro
+	eI2C_STATE_SEND_DATA,      //Esperando BTF de cada dato
+	eI2C_STATE_START_READ,     //Esperando SB del restart para enviar dirección + R
+	eI2C_STATE_ADDR_READ,      //Esperando ADDR para programar ACK/POS según N
+	eI2C_STATE_RECEIVE,        //Recibiendo datos
+	eI2C_STATE_DMA_TX,         //El DMA está escribiendo los datos
+	eI2C_STATE_DMA_RX,         //El DMA está leyendo los datos
+	eI2C_STATE_WAIT_STOP       //El STOP anterior no ha salido, el START se genera en un evento posterior
+};
+
+#define I2C_INSTANCES    3
+
+/* Motor de transacciones de cada periférico I2C */
+typedef struct
+{
+	I2C_TypeDef         *pI2Cx;
+	I2C_Transaction_t   *queue[eI2C_PRIORITY_COUNT][I2C_QUEUE_SIZE];   //Una cola por clase de prioridad
+	uint8_t             queueHead[eI2C_PRIORITY_COUNT];
+	uint8_t             queueTail[eI2C_PRIORITY_COUNT];
+	I2C_Transaction_t   *pCurrent;
+	volatile uint8_t    state;
+	uint8_t             dataIndex;
+	uint8_t             remaining;
+	uint8_t             dmaEnabled;
+	DMA_Handler_t       dmaRx;
+	DMA_Handler_t       dmaTx;
+	I2C_SlaveRegFile_t  *pSlave;       //Distinto de 0 en modo esclavo
+}I2C_Engine_t;
+
+static I2C_Engine_t i2cEngine[I2C_INSTANCES] = {
+		{ .pI2Cx = I2C1 }, { .pI2Cx = I2C2 }, { .pI2Cx = I2C3 }
+};
+
+/* Vectores de eventos y de errores de cada periférico */
+static const IRQn_Type i2cEventIRQn[I2C_INSTANCES] = { I2C1_EV_IRQn, I2C2_EV_IRQn, I2C3_EV_IRQn };
+static const IRQn_Type i2cErrorIRQn[I2C_INSTANCES] = { I2C1_ER_IRQn, I2C2_ER_IRQn, I2C3_ER_IRQn };
+
+/*
+ * Streams del DMA1 para cada periférico (tabla 28 del manual de referencia).
+ * NOTA: I2C1_TX e I2C2_TX comparten el Stream7, no se puede usar el DMA en ambos a la vez
+ * (i2c_ConfigDma() rechaza el segundo, que sigue funcionando por interrupciones).
+ */
+static DMA_Stream_TypeDef * const i2cDmaRxStream[I2C_INSTANCES] = { DMA1_Stream0, DMA1_Stream3, DMA1_Stream2 };
+static DMA_Stream_TypeDef * const i2cDmaTxStream[I2C_INSTANCES] = { DMA1_Stream7, DMA1_Stream7, DMA1_Stream4 };
+static const uint8_t i2cDmaRxChannel[I2C_INSTANCES] = { DMA_CHANNEL_1, DMA_CHANNEL_7, DMA_CHANNEL_3 };
+static const uint8_t i2cDmaTxChannel[I2C_INSTANCES] = { DMA_CHANNEL_1, DMA_CHANNEL_7, DMA_CHANNEL_3 };
+
 /*==== Headers for private functions ====*/
 static void i2c_enable_clock_peripheral(I2C_Handler_t  *pHandlerI2C);
 static void i2c_soft_reset(I2C_Handler_t  *pHandlerI2C);
@@ -20,17 +75,40 @@ static void i2c_set_mode(I2C_Handler_t  *pHandlerI2C);
 static void i2c_enable_port(I2C_Handler_t  *pHandlerI2C);
 static void i2c_disable_port(I2C_Handler_t  *pHandlerI2C);
 static void i2c_stop_signal(I2C_Handler_t  *pHandlerI2C);
-static void i2c_start_signal(I2C_Handler_t  *pHandlerI2C);
-static void i2c_restart_signal(I2C_Handler_t  *pHandlerI2C);
+static uint8_t i2c_start_signal(I2C_Handler_t  *pHandlerI2C);
+static uint8_t i2c_restart_signal(I2C_Handler_t  *pHandlerI2C);
 static void i2c_send_no_ack(I2C_Handler_t  *pHandlerI2C);
 static void i2c_send_ack(I2C_Handler_t  *pHandlerI2C);
-static void i2c_send_slave_address_rw(I2C_Handler_t  *pHandlerI2C, uint8_t rw);
-static void i2c_send_memory_address(I2C_Handler_t  *pHandlerI2C, uint8_t memAddr);
-static void i2c_send_close_comm(I2C_Handler_t  *pHandlerI2C);
-static void i2c_send_byte(I2C_Handler_t  *pHandlerI2C, uint8_t dataToWrite);
-static uint8_t i2c_read_byte(I2C_Handler_t  *pHandlerI2C);
-
-//static void i2c_config_interrupt(I2C_Handler_t *pHandlerI2C);
+static uint8_t i2c_wait_flag(I2C_Handler_t  *pHandlerI2C, uint32_t flag);
+static uint8_t i2c_send_slave_address_rw(I2C_Handler_t  *pHandlerI2C, uint8_t rw);
+static void i2c_clear_address_flag(I2C_Handler_t  *pHandlerI2C);
+static uint8_t i2c_receive_bytes(I2C_Handler_t  *pHandlerI2C, uint8_t *bufferRxData, uint8_t numberOfBytes);
+static uint8_t i2c_send_memory_address(I2C_Handler_t  *pHandlerI2C, uint8_t memAddr);
+static uint8_t i2c_send_close_comm(I2C_Handler_t  *pHandlerI2C);
+static uint8_t i2c_send_byte(I2C_Handler_t  *pHandlerI2C, uint8_t dataToWrite);
+static uint8_t i2c_read_byte(I2C_Handler_t  *pHandlerI2C, uint8_t *pData);
+static uint8_t i2c_end_transaction(I2C_Handler_t  *pHandlerI2C, uint8_t status);
+static int8_t i2c_cache_index(I2C_RegCache_t *pRegCache, uint8_t regAddress);
+static uint8_t i2c_cache_read(I2C_Handler_t  *pHandlerI2C, uint8_t regToRead, uint8_t *pData, uint8_t numberOfBytes);
+static uint8_t i2c_cache_write_is_redundant(I2C_Handler_t  *pHandlerI2C, uint8_t regToWrite, uint8_t *pData, uint8_t numberOfBytes);
+static void i2c_cache_update(I2C_Handler_t  *pHandlerI2C, uint8_t regAddress, uint8_t *pData, uint8_t numberOfBytes);
+
+static void i2c_config_interrupt(I2C_Handler_t *pHandlerI2C);
+static I2C_Engine_t *i2c_get_engine(I2C_TypeDef *pI2Cx);
+static uint8_t i2c_transaction_priority(I2C_Transaction_t *pTransaction);
+static uint8_t i2c_queue_free(I2C_Engine_t *pEngine, uint8_t priority);
+static void i2c_queue_push(I2C_Engine_t *pEngine, uint8_t priority, I2C_Transaction_t *pTransaction);
+static void i2c_update_client_stats(I2C_Transaction_t *pTransaction, uint8_t status);
+static void i2c_slave_event(I2C_Engine_t *pEngine);
+static void i2c_slave_error(I2C_Engine_t *pEngine);
+static void i2c_slave_end_transaction(I2C_SlaveRegFile_t *pRegFile);
+static void i2c_engine_start_next(I2C_Engine_t *pEngine);
+static void i2c_engine_launch(I2C_Engine_t *pEngine);
+static void i2c_engine_finish(I2C_Engine_t *pEngine, uint8_t status);
+static void i2c_engine_event(I2C_Engine_t *pEngine);
+static void i2c_engine_error(I2C_Engine_t *pEngine);
+static void i2c_engine_dma(I2C_Engine_t *pEngine, DMA_Stream_TypeDef *pStream);
+static void i2c_config_dma_stream(DMA_Handler_t *pDMAHandler, DMA_Stream_TypeDef *pStream, uint8_t channel, uint8_t direction);
 
 /*
  * Recordar que se debe configurar los pines para el I2C (SDA Y SCL),
@@ -62,6 +140,12 @@ void i2c_Config(I2C_Handler_t *pHandlerI2C){
 	/*5. Activamos el módulo I2C*/
 	i2c_enable_port(pHandlerI2C);
 
+	/*6. Matriculamos las interrupciones de eventos y errores en el NVIC. Los bits ITEVTEN/ITERREN
+	 * solo se activan mientras hay transacciones no bloqueantes en curso*/
+	__disable_irq();
+	i2c_config_interrupt(pHandlerI2C);
+	__enable_irq();
+
 	//i2c_stopTransaction(ptrHandlerI2C);
 }
 
@@ -82,43 +166,100 @@ static void i2c_enable_clock_peripheral(I2C_Handler_t  *pHandlerI2C){
 	}
 }
 
-/**/
+/*
+ * El campo FREQ debe tener la frecuencia del PCLK1 en MHz (2 - 50 MHz), ya que con ella
+ * el periférico mide los tiempos del bus. Se toma del RCC y se guarda en el handler.
+ * */
 static void i2c_set_main_clock(I2C_Handler_t  *pHandlerI2C){
+
+	pHandlerI2C->i2c_mainClock = rcc_GetPclk1() / 1000000;
+
 	pHandlerI2C->pI2Cx->CR2 &= ~(0b111111 << I2C_CR2_FREQ_Pos); //Borramos la configuración previa
 	pHandlerI2C->pI2Cx->CR2 |= (pHandlerI2C->i2c_mainClock << I2C_CR2_FREQ_Pos);
 }
 
-/**/
+/*
+ * Calcula CCR y TRISE a partir del PCLK1 y la velocidad pedida (sección 18.6.8 y 18.6.9):
+ * - SM:            T(SCL) = 2 * CCR * T(PCLK1)
+ * - FM, DUTY = 0:  T(SCL) = 3 * CCR * T(PCLK1)
+ * - FM, DUTY = 1:  T(SCL) = 25 * CCR * T(PCLK1)
+ * El CCR se redondea hacia arriba, de forma que el bus nunca supera la velocidad pedida.
+ * TRISE = tRise(max) / T(PCLK1) + 1
+ * */
 static void i2c_set_mode(I2C_Handler_t  *pHandlerI2C){
 
+	uint32_t pclk1     = rcc_GetPclk1();
+	uint32_t speedHz   = pHandlerI2C->i2c_speedHz;
+	uint32_t divider   = 2;
+	uint32_t ccrValue  = 0;
+	uint32_t riseTime  = I2C_MAX_RISE_TIME_SM_NS;
+
+	if(speedHz == 0){
+		speedHz = (pHandlerI2C->i2c_mode == eI2C_MODE_SM) ? I2C_SPEED_SM_HZ : I2C_SPEED_FM_HZ;
+	}
+
 	/*Borramos la información de ambos registros (aunque esto lo debe hacer el reset)*/
 	pHandlerI2C->pI2Cx->CCR = 0;
 	pHandlerI2C->pI2Cx->TRISE = 0;
 
 	if(pHandlerI2C->i2c_mode == eI2C_MODE_SM){
-
 		//Estamos en modo standar (SM MODE)
-		//Seleccionamos el modo estándar
-		pHandlerI2C->pI2Cx->CCR &= ~I2C_CCR_FS;
-
-		//Configuramos el registro que se encarga de generar la señal de reloj
-		pHandlerI2C->pI2Cx->CCR |= (I2C_MODE_SM_SPEED << I2C_CCR_CCR_Pos);
-
-		//Configuramos el registro que controla el tiempo T-Rise máximo
-		pHandlerI2C->pI2Cx->TRISE |= I2C_MAX_RISE_TIME_SM;
+		divider  = 2;
+		riseTime = I2C_MAX_RISE_TIME_SM_NS;
 	}
 	else{
-
 		//Estamos en modo Fast (FM MODE)
-		//Seleccionamos el mod Fast
 		pHandlerI2C->pI2Cx->CCR |= I2C_CCR_FS;
+		riseTime = I2C_MAX_RISE_TIME_FM_NS;
+
+		if(pHandlerI2C->i2c_duty == eI2C_DUTY_16_9){
+			pHandlerI2C->pI2Cx->CCR |= I2C_CCR_DUTY;
+			divider = 25;
+		}
+		else{
+			divider = 3;
+		}
+	}
+
+	//Configuramos el registro que se encarga de generar la señal de reloj
+	ccrValue = (pclk1 + (divider * speedHz) - 1) / (divider * speedHz);
+
+	//Límites del campo CCR: mínimo 4 en SM y 1 en FM, máximo 12 bits
+	if((pHandlerI2C->i2c_mode == eI2C_MODE_SM) && (ccrValue < 4)){
+		ccrValue = 4;
+	}
+	else if(ccrValue < 1){
+		ccrValue = 1;
+	}
+	else if(ccrValue > 0xFFF){
+		ccrValue = 0xFFF;
+	}
 
-		//Configuramos el registro que se encarga de generar la señal de reloj
-		pHandlerI2C->pI2Cx->CCR |= (I2C_MODE_FM_SPEED << I2C_CCR_CCR_Pos);
+	pHandlerI2C->pI2Cx->CCR |= (ccrValue << I2C_CCR_CCR_Pos);
 
-		//Configuramos el registro que controla el tiempo T-Rise máximo
-		pHandlerI2C->pI2Cx->TRISE |= I2C_MAX_RISE_TIME_FM;
+	//Configuramos el registro que controla el tiempo T-Rise máximo
+	pHandlerI2C->pI2Cx->TRISE = ((pclk1 / 1000000) * riseTime) / 1000 + 1;
+}
+
+/*
+ * Frecuencia real del SCL en Hz, calculada con los valores que quedaron en el CCR
+ * (sin contar el alargamiento por el tiempo de subida de las líneas).
+ * */
+uint32_t i2c_GetBusFrequency(I2C_Handler_t *pHandlerI2C){
+
+	uint32_t auxCCR   = pHandlerI2C->pI2Cx->CCR;
+	uint32_t ccrValue = (auxCCR & I2C_CCR_CCR) >> I2C_CCR_CCR_Pos;
+	uint32_t divider  = 2;
+
+	if(ccrValue == 0){
+		return 0;
+	}
+
+	if(auxCCR & I2C_CCR_FS){
+		divider = (auxCCR & I2C_CCR_DUTY) ? 25 : 3;
 	}
+
+	return rcc_GetPclk1() / (divider * ccrValue);
 }
 
 /*
@@ -169,8 +310,10 @@ static void i2c_stop_signal(I2C_Handler_t  *pHandlerI2C){
  * 3.Leemos el registro SR1
  *
  * Estos pasos hacen parte del evento EV5 de la figura 164
+ * Todas las esperas tienen tiempo límite (I2C_TIMEOUT_US): si el esclavo deja el bus
+ * tomado o no responde, la función retorna eI2C_STATUS_TIMEOUT en lugar de bloquear el MCU.
  * */
-static void i2c_start_signal(I2C_Handler_t  *pHandlerI2C){
+static uint8_t i2c_start_signal(I2C_Handler_t  *pHandlerI2C){
 
 	/*0. Definimos una variable auxiliar*/
 	uint8_t auxByte = 0;
@@ -181,9 +324,6 @@ static void i2c_start_signal(I2C_Handler_t  *pHandlerI2C){
 	//https://community.st.com/t5/stm32-mcus-products/stm32f2xx-i2c-not-sending-address-after-start/td-p/423510
 	//pHandlerI2C->pI2Cx->CR1 &= ~I2C_CR1_STOP;
 
-	/*0. Reset para tener el periférico en un estado conocido*/
-	//i2c_softReset(ptrHandlerI2C);
-
 	/*1. Configuramos el control para generar el bit ACK
 	 * Este bit posición lo que hace es controlar si nuestro bit ACK genera dicha
 	 * señal para el byte que se está leyendo actualmente (I2C_CR1_POS = 0) o para el Byte
@@ -197,10 +337,10 @@ static void i2c_start_signal(I2C_Handler_t  *pHandlerI2C){
 
 	/*2a. Esperamos a que la bandera del evento start se levante.
 	 * Este bit se hace 1 si y solo si una señal de start se genera satisfactoriamente.
-	 * Mientras esperamos, el valor de SB es 0, entonces la negación <(!) es 1
+	 * Si otro dispositivo tiene el bus tomado (SDA en bajo) el START nunca se genera.
 	 * */
-	while(!(pHandlerI2C->pI2Cx->SR1 & I2C_SR1_SB)){
-		__NOP();
+	if(i2c_wait_flag(pHandlerI2C, I2C_SR1_SB) != eI2C_STATUS_OK){
+		return eI2C_STATUS_TIMEOUT;
 	}
 
 	/*El sistema espera que el registro SR1 sea leido, para continuar con el siguiente paso, que es
@@ -211,14 +351,15 @@ static void i2c_start_signal(I2C_Handler_t  *pHandlerI2C){
 
 	auxByte = pHandlerI2C->pI2Cx->SR1;
 
+	return eI2C_STATUS_OK;
 }
 
 /*Según el manual, hacer una señal de start luego de la transferencia de un byte
  * nos genera una señal de restart, por lo cual es suficiente con hacer un nuevo start
  * */
-static void i2c_restart_signal(I2C_Handler_t  *pHandlerI2C){
+static uint8_t i2c_restart_signal(I2C_Handler_t  *pHandlerI2C){
 	/*2. Generamos la señal de start*/
-	i2c_start_signal(pHandlerI2C);
+	return i2c_start_signal(pHandlerI2C);
 }
 
 /*
@@ -240,6 +381,30 @@ static void i2c_send_ack(I2C_Handler_t  *pHandlerI2C){
 	pHandlerI2C->pI2Cx->CR1 |= I2C_CR1_ACK;
 }
 
+/*
+ * Espera (con tiempo límite) a que se levante la bandera flag del SR1.
+ * Si en el camino el esclavo responde con NACK (AF), la espera termina de inmediato.
+ * */
+static uint8_t i2c_wait_flag(I2C_Handler_t  *pHandlerI2C, uint32_t flag){
+
+	Deadline_t deadline = deadline_Start(I2C_TIMEOUT_US);
+
+	while(!(pHandlerI2C->pI2Cx->SR1 & flag)){
+
+		if(pHandlerI2C->pI2Cx->SR1 & I2C_SR1_AF){
+			//La bandera AF se baja escribiendo 0
+			pHandlerI2C->pI2Cx->SR1 &= ~I2C_SR1_AF;
+			return eI2C_STATUS_NACK;
+		}
+
+		if(deadline_Expired(&deadline)){
+			return eI2C_STATUS_TIMEOUT;
+		}
+	}
+
+	return eI2C_STATUS_OK;
+}
+
 /*
  * Este es el paso siguiente a la señal start (o restart) y siempre es la dirección del
  * esclavo mas la indicación de si se desea leer (1) o escribir (0).
@@ -254,11 +419,7 @@ static void i2c_send_ack(I2C_Handler_t  *pHandlerI2C){
 /*
  * Descrito entre los eventos EV5 y EV6 de la figura 164
  * */
-static void i2c_send_slave_address_rw(I2C_Handler_t  *pHandlerI2C, uint8_t rw){
-
-	/*0. Definimos una variable auxiliar*/
-	uint8_t auxByte = 0;
-	(void) auxByte;
+static uint8_t i2c_send_slave_address_rw(I2C_Handler_t  *pHandlerI2C, uint8_t rw){
 
 	/*3. Enviamos la dirección del Slave y el bit que indica que deseamos escribir (0)
 	 * (en el siguiente paso se envía la dirección de memoria que se desea escribir)
@@ -266,32 +427,146 @@ static void i2c_send_slave_address_rw(I2C_Handler_t  *pHandlerI2C, uint8_t rw){
 	pHandlerI2C->pI2Cx->DR = (pHandlerI2C->slaveAddress <<1) | rw;
 
 	/*3.1 Esperamos hasta que la bandera del evento addr se levante
-	 * (esto nos indica que la dirección fué enviada satisfactoriamente)*
-	*/
-	while(!(pHandlerI2C->pI2Cx->SR1 & I2C_SR1_ADDR)){
-		__NOP();
-	}
+	 * (esto nos indica que la dirección fué enviada satisfactoriamente).
+	 * Si ningún esclavo tiene esa dirección se recibe un NACK.
+	 *
+	 * La bandera ADDR NO se limpia aquí: mientras esté en 1 el SCL se mantiene en bajo,
+	 * lo que da tiempo de configurar ACK/POS/STOP antes de que el esclavo envíe el
+	 * primer byte (necesario en lectura). Se limpia con i2c_clear_address_flag().
+	 * */
+	return i2c_wait_flag(pHandlerI2C, I2C_SR1_ADDR);
+}
+
+/*
+ * 3.2 Debemos limpiar la bandera de la recepción de ACK de la addr, para lo cual
+ * debemos leer en secuencia primero el I2C_SR1 y luego I2C_SR2.
+ * El bit TRA del registro SR2 nos indica si el equipo quedó en modo transmisión
+ * o en modo recepción, lo cual está definido por el tipo de selección de R/W que se envió
+ * pag. 480 del manual.
+ * */
+static void i2c_clear_address_flag(I2C_Handler_t  *pHandlerI2C){
+
+	/*0. Definimos una variable auxiliar*/
+	uint8_t auxByte = 0;
+	(void) auxByte;
 
-	/*3.2 Debemos limpiar la bandera de la recepción de ACK de la addr, para lo cual
-	 * debemos leer en secuencia primero el I2C_SR1 y luego I2C_SR2*/
 	auxByte = pHandlerI2C->pI2Cx->SR1;
 	auxByte = pHandlerI2C->pI2Cx->SR2;
-	/*El bit TRA del registro SR2 nos indica si el equipo quedó en modo transmisión
-	 * o en modo recepción, lo cual está definido por el tipo de selección de R/W que se envió
-	 * pag. 480 del manual.
-	 * */
+}
+
+/*
+ * Recibe numberOfBytes bytes luego de enviar la dirección del esclavo con la indicación
+ * de LEER (con ADDR aún sin limpiar). El NACK y el STOP se deben programar antes de que
+ * el hardware termine de recibir el último byte, por lo que el manual de referencia
+ * (sección 18.3.3, "Closing the communication") define tres secuencias:
+ *
+ * - N = 1: ACK = 0, limpiar ADDR, STOP = 1, esperar RXNE y leer.
+ * - N = 2: ACK = 0 y POS = 1 (el NACK aplica al segundo byte), limpiar ADDR,
+ *          esperar BTF, STOP = 1 y leer los dos bytes.
+ * - N > 2: ACK = 1, limpiar ADDR y leer con RXNE hasta que queden 3 bytes. Luego
+ *          esperar BTF, ACK = 0, leer N-2, esperar BTF, STOP = 1, leer N-1 y N.
+ *
+ * Los pasos entre limpiar ADDR (o leer N-2) y programar el STOP no deben ser interrumpidos,
+ * de lo contrario el esclavo puede alcanzar a enviar un byte de más.
+ * */
+static uint8_t i2c_receive_bytes(I2C_Handler_t  *pHandlerI2C, uint8_t *bufferRxData, uint8_t numberOfBytes){
+
+	uint8_t status = eI2C_STATUS_OK;
+
+	if(numberOfBytes == 1){
+
+		/*6. Generamos la condición de NOAck, para que el slave solo envie 1 byte*/
+		i2c_send_no_ack(pHandlerI2C);
+
+		__disable_irq();
+		i2c_clear_address_flag(pHandlerI2C);
+
+		/*7. Generamos la condición stop, para que el slave se detenga después de 1 byte*/
+		i2c_stop_signal(pHandlerI2C);
+		__enable_irq();
+
+		/*8. Leemos el dato que envia el esclavo*/
+		return i2c_read_byte(pHandlerI2C, bufferRxData);
+	}
+	else if(numberOfBytes == 2){
+
+		/*6. El NACK se aplica al byte que llega después del que está en recepción*/
+		i2c_send_no_ack(pHandlerI2C);
+		pHandlerI2C->pI2Cx->CR1 |= I2C_CR1_POS;
+
+		i2c_clear_address_flag(pHandlerI2C);
+
+		/*7. Esperamos a tener los dos bytes (uno en DR y otro en el registro de desplazamiento)*/
+		status = i2c_wait_flag(pHandlerI2C, I2C_SR1_BTF);
+		if(status != eI2C_STATUS_OK){
+			return status;
+		}
+
+		__disable_irq();
+		i2c_stop_signal(pHandlerI2C);
+
+		/*8. Leemos los dos datos*/
+		*bufferRxData = pHandlerI2C->pI2Cx->DR;
+		__enable_irq();
+		bufferRxData++;
+		status = i2c_read_byte(pHandlerI2C, bufferRxData);
+
+		pHandlerI2C->pI2Cx->CR1 &= ~I2C_CR1_POS;
+		return status;
+	}
+	else{
+
+		/*6. Activamos el envío de ACK para todos los bytes menos los dos últimos*/
+		i2c_send_ack(pHandlerI2C);
+
+		i2c_clear_address_flag(pHandlerI2C);
+
+		/*7. Leemos hasta que solo queden 3 bytes por recibir*/
+		while(numberOfBytes > 3){
+			status = i2c_read_byte(pHandlerI2C, bufferRxData);
+			if(status != eI2C_STATUS_OK){
+				return status;
+			}
+			bufferRxData++;
+			numberOfBytes--;
+		}
+
+		/*8. DataN-2 en el DR y DataN-1 en el registro de desplazamiento*/
+		status = i2c_wait_flag(pHandlerI2C, I2C_SR1_BTF);
+		if(status != eI2C_STATUS_OK){
+			return status;
+		}
+		i2c_send_no_ack(pHandlerI2C);
+
+		__disable_irq();
+		*bufferRxData = pHandlerI2C->pI2Cx->DR;
+		bufferRxData++;
+
+		/*9. DataN-1 en el DR y DataN en el registro de desplazamiento*/
+		status = i2c_wait_flag(pHandlerI2C, I2C_SR1_BTF);
+		if(status != eI2C_STATUS_OK){
+			__enable_irq();
+			return status;
+		}
+		i2c_stop_signal(pHandlerI2C);
+
+		*bufferRxData = pHandlerI2C->pI2Cx->DR;
+		__enable_irq();
+		bufferRxData++;
+
+		/*10. Último byte*/
+		return i2c_read_byte(pHandlerI2C, bufferRxData);
+	}
 }
 
 /**/
-static void i2c_send_byte(I2C_Handler_t  *pHandlerI2C, uint8_t dataToWrite){
+static uint8_t i2c_send_byte(I2C_Handler_t  *pHandlerI2C, uint8_t dataToWrite){
 
 	/*5. Cargamos el valor que deseamos escribir*/
 	pHandlerI2C->pI2Cx->DR = dataToWrite;
 
 	/*5.1 Esperamos hasta que el byte sea montado en el DSR, quedando el DR libre de nuevo*/
-	while(!(pHandlerI2C->pI2Cx->SR1 & I2C_SR1_TXE)){
-		__NOP();
-	}
+	return i2c_wait_flag(pHandlerI2C, I2C_SR1_TXE);
 }
 
 /*
@@ -299,162 +574,1123 @@ static void i2c_send_byte(I2C_Handler_t  *pHandlerI2C, uint8_t dataToWrite){
  * es igual a enviar un byte x cualquiera, por lo cual simplemente se llama a la función enviar un
  * byte genérico, el cual es la posición de memoria que se desea leer.
  * */
-static void i2c_send_memory_address(I2C_Handler_t  *pHandlerI2C, uint8_t memAddr){
-	i2c_send_byte(pHandlerI2C, memAddr);
+static uint8_t i2c_send_memory_address(I2C_Handler_t  *pHandlerI2C, uint8_t memAddr){
+	return i2c_send_byte(pHandlerI2C, memAddr);
 }
 
 /* Esta función evalua que el último byte ha sido transmitido completamente por el TSR,
  * luego de esto, transmite la señal de stop
  * */
-static void i2c_send_close_comm(I2C_Handler_t  *pHandlerI2C){
+static uint8_t i2c_send_close_comm(I2C_Handler_t  *pHandlerI2C){
 
 	/*5.1 Esperamos hasta que el último byte sea transmitido completamente por el TSR
-	 * lo cual activa el bit BTF, quedando tanto BTF como TXE en 1
+	 * lo cual activa el bit BTF, quedando tanto BTF como TXE en 1.
+	 * Así también se detecta el NACK del último byte.
 	 * */
-//	while(!(pHandlerI2C->pI2Cx->SR1 & I2C_SR1_BTF)){
-//		__NOP();
-//	}
+	uint8_t status = i2c_wait_flag(pHandlerI2C, I2C_SR1_BTF);
 
 	/*Enviamos la señal de detención*/
 	i2c_stop_signal(pHandlerI2C);
+
+	return status;
 }
 
 /**/
-static uint8_t i2c_read_byte(I2C_Handler_t  *pHandlerI2C){
+static uint8_t i2c_read_byte(I2C_Handler_t  *pHandlerI2C, uint8_t *pData){
 
 	/*9. Esperamos hasta que el byte entrante sea recibido*/
-	while(!(pHandlerI2C->pI2Cx->SR1 & I2C_SR1_RXNE)){
-		__NOP();
+	uint8_t status = i2c_wait_flag(pHandlerI2C, I2C_SR1_RXNE);
+
+	if(status == eI2C_STATUS_OK){
+		pHandlerI2C->i2c_data = pHandlerI2C->pI2Cx->DR;
+		*pData = pHandlerI2C->i2c_data;
 	}
 
-	pHandlerI2C->i2c_data = pHandlerI2C->pI2Cx->DR;
+	return status;
+}
+
+/*
+ * Guarda el resultado de la transacción bloqueante en el handler y deja el bus en un
+ * estado conocido si algo salió mal:
+ * - NACK: se libera el bus con STOP.
+ * - TIMEOUT: el bus o el periférico quedaron bloqueados, se ejecuta la recuperación.
+ * */
+static uint8_t i2c_end_transaction(I2C_Handler_t  *pHandlerI2C, uint8_t status){
+
+	pHandlerI2C->i2c_status = status;
+
+	/* Después de un error no se sabe qué recibió el dispositivo */
+	if(status != eI2C_STATUS_OK){
+		i2c_InvalidateCache(pHandlerI2C);
+	}
 
-	return pHandlerI2C->i2c_data;
+	if(status == eI2C_STATUS_NACK){
+		i2c_stop_signal(pHandlerI2C);
+	}
+	else if(status != eI2C_STATUS_OK){
+		i2c_RecoverBus(pHandlerI2C);
+	}
+
+	pHandlerI2C->pI2Cx->CR1 &= ~I2C_CR1_POS;
+
+	return status;
 }
 
 /*====== Funciones públicas del driver ======*/
 
-/**/
-uint8_t i2c_ReadSingleRegister(I2C_Handler_t *pHandlerI2C, uint8_t regToRead){
+/*
+ * Guarda los pines SDA y SCL (ya configurados en función alternativa, open-drain).
+ * Son necesarios para poder recuperar el bus con i2c_RecoverBus().
+ * */
+void i2c_SetPins(I2C_Handler_t *pHandlerI2C, GPIO_Handler_t *setSdaPin, GPIO_Handler_t *setSclPin){
 
-	/*0. Creamos una variable auxiliar para recibir el dato que leemos*/
-	uint8_t auxRead = 0;
+	pHandlerI2C->pSdaPin = setSdaPin;
+	pHandlerI2C->pSclPin = setSclPin;
+}
 
-	/*1. Generamos la condición de start*/
-	i2c_start_signal(pHandlerI2C);
+/*
+ * Recuperación del bus (I2C specification UM10204, sección 3.1.16 "Bus clear"):
+ * si un esclavo quedó a mitad de un byte sostiene SDA en bajo y el maestro no puede
+ * generar START. Se toman los pines como GPIO open-drain, se generan hasta 9 pulsos en SCL
+ * hasta que el esclavo suelte SDA, y luego una condición de STOP manual. Finalmente se
+ * reinicia el periférico (SWRST) y se vuelve a ejecutar i2c_Config().
+ * Sin pines registrados (i2c_SetPins) solo se reinicia el periférico.
+ * */
+void i2c_RecoverBus(I2C_Handler_t *pHandlerI2C){
 
-	/*2. Enviamos la dirección del esclavo y la indicación de ESCRIBIR */
-	i2c_send_slave_address_rw(pHandlerI2C, eI2C_WRITE_DATA);
+	GPIO_Handler_t sdaPinGpio = {0};
+	GPIO_Handler_t sclPinGpio = {0};
+	uint8_t pulse = 0;
 
-	/*3. Enviamos la dirección de memoria que deseamos LEER*/
-	i2c_send_memory_address(pHandlerI2C, regToRead);
+	/*1. Apagamos el periférico para que suelte los pines*/
+	i2c_disable_port(pHandlerI2C);
 
-	/*4. Creamos una condición de restart*/
-	i2c_restart_signal(pHandlerI2C);
+	if((pHandlerI2C->pSdaPin != 0) && (pHandlerI2C->pSclPin != 0)){
+
+		/*2. Los mismos pines, pero como salidas open-drain controladas por software*/
+		sdaPinGpio = *pHandlerI2C->pSdaPin;
+		sclPinGpio = *pHandlerI2C->pSclPin;
+		sdaPinGpio.pinConfig.GPIO_PinMode       = GPIO_MODE_OUT;
+		sclPinGpio.pinConfig.GPIO_PinMode       = GPIO_MODE_OUT;
+		sdaPinGpio.pinConfig.GPIO_PinOutputType = GPIO_OTYPE_OPENDRAIN;
+		sclPinGpio.pinConfig.GPIO_PinOutputType = GPIO_OTYPE_OPENDRAIN;
+
+		gpio_WritePin(&sdaPinGpio, SET);
+		gpio_WritePin(&sclPinGpio, SET);
+		gpio_Config(&sdaPinGpio);
+		gpio_Config(&sclPinGpio);
+
+		/*3. Hasta 9 pulsos de reloj, terminando cuando el esclavo suelta SDA*/
+		for(pulse = 0; pulse < 9; pulse++){
+			if(gpio_ReadPin(&sdaPinGpio)){
+				break;
+			}
+			gpio_WritePin(&sclPinGpio, RESET);
+			deadline_DelayUs(I2C_RECOVERY_HALF_PERIOD_US);
+			gpio_WritePin(&sclPinGpio, SET);
+			deadline_DelayUs(I2C_RECOVERY_HALF_PERIOD_US);
+		}
 
-	/*5. Enviamos la direcciń del esclavo y la indicación de LEER*/
-	i2c_send_slave_address_rw(pHandlerI2C, eI2C_READ_DATA);
+		/*4. Condición de STOP: SDA sube mientras SCL está en alto*/
+		gpio_WritePin(&sclPinGpio, RESET);
+		gpio_WritePin(&sdaPinGpio, RESET);
+		deadline_DelayUs(I2C_RECOVERY_HALF_PERIOD_US);
+		gpio_WritePin(&sclPinGpio, SET);
+		deadline_DelayUs(I2C_RECOVERY_HALF_PERIOD_US);
+		gpio_WritePin(&sdaPinGpio, SET);
+		deadline_DelayUs(I2C_RECOVERY_HALF_PERIOD_US);
+
+		/*5. Devolvemos los pines a la función alternativa del I2C*/
+		gpio_Config(pHandlerI2C->pSdaPin);
+		gpio_Config(pHandlerI2C->pSclPin);
+	}
 
-	/*8. Leemos el dato que envia el esclavo*/
-	auxRead = i2c_read_byte(pHandlerI2C);
+	/*6. Reinicio del periférico (borra BUSY y cualquier estado interno) y nueva configuración*/
+	i2c_Config(pHandlerI2C);
+}
 
-	/*6. Generamos la condición de NOAck, para que el Master no responde y el slave solo envie 1 byte*/
-	i2c_send_no_ack(pHandlerI2C);
+/*
+ * Retorna el dato leído. El resultado de la transacción queda en pHandlerI2C->i2c_status.
+ * */
+uint8_t i2c_ReadSingleRegister(I2C_Handler_t *pHandlerI2C, uint8_t regToRead){
 
-	/*7. Generamos la condición stop, para que el slave se detenga después de 1 byte*/
-	i2c_stop_signal(pHandlerI2C);
-	//i2c_send_close_comm(pHandlerI2C);
+	/*0. Creamos una variable auxiliar para recibir el dato que leemos*/
+	uint8_t auxRead = 0;
+
+	/*1 - 8. Es una lectura de un solo byte (secuencia N = 1)*/
+	i2c_ReadManyRegisters(pHandlerI2C, regToRead, &auxRead, 1);
 
 	return auxRead;
 }
 
-/**/
+/*
+ * Lee numberOfBytes registros consecutivos a partir de regToRead en una sola transacción
+ * (el esclavo incrementa la dirección interna con cada byte).
+ * Retorna eI2C_STATUS_OK (0) si todo salió bien, o el código del error.
+ * */
 uint8_t i2c_ReadManyRegisters(I2C_Handler_t *pHandlerI2C, uint8_t regToRead, uint8_t *bufferRxData, uint8_t numberOfBytes){
 
+	uint8_t status = eI2C_STATUS_OK;
+
+	if(numberOfBytes == 0){
+		return eI2C_STATUS_OK;
+	}
+
+	/*0. Registros de configuración que ya están en el caché*/
+	if(i2c_cache_read(pHandlerI2C, regToRead, bufferRxData, numberOfBytes)){
+		pHandlerI2C->i2c_status = eI2C_STATUS_OK;
+		return eI2C_STATUS_OK;
+	}
+
+	/*0. El bus no se puede usar mientras el motor no bloqueante tenga transacciones*/
+	if(!i2c_IsIdle(pHandlerI2C)){
+		pHandlerI2C->i2c_status = eI2C_STATUS_BUSY;
+		return eI2C_STATUS_BUSY;
+	}
+
 	/*1. Generamos la condición de start*/
-	i2c_start_signal(pHandlerI2C);
+	status = i2c_start_signal(pHandlerI2C);
 
 	/*2. Enviamos la dirección del esclavo y la indicación de ESCRIBIR*/
-	i2c_send_slave_address_rw(pHandlerI2C, eI2C_WRITE_DATA);
+	if(status == eI2C_STATUS_OK){
+		status = i2c_send_slave_address_rw(pHandlerI2C, eI2C_WRITE_DATA);
+	}
 
 	/*3. Enviamos la dirección de memoria desde donde deseamos leer*/
-	i2c_send_memory_address(pHandlerI2C, regToRead);
+	if(status == eI2C_STATUS_OK){
+		i2c_clear_address_flag(pHandlerI2C);
+		status = i2c_send_memory_address(pHandlerI2C, regToRead);
+	}
 
 	/*4. Creamos una condición de restart*/
-	i2c_restart_signal(pHandlerI2C);
+	if(status == eI2C_STATUS_OK){
+		status = i2c_restart_signal(pHandlerI2C);
+	}
 
 	/*5. Enviamos la dirección del esclavo y la indicación de LEER*/
-	i2c_send_slave_address_rw(pHandlerI2C, eI2C_READ_DATA);
+	if(status == eI2C_STATUS_OK){
+		status = i2c_send_slave_address_rw(pHandlerI2C, eI2C_READ_DATA);
+	}
+
+	/*6 - 10. Recibimos los datos con la secuencia que corresponde a numberOfBytes*/
+	if(status == eI2C_STATUS_OK){
+		status = i2c_receive_bytes(pHandlerI2C, bufferRxData, numberOfBytes);
+	}
+
+	status = i2c_end_transaction(pHandlerI2C, status);
+
+	if(status == eI2C_STATUS_OK){
+		i2c_cache_update(pHandlerI2C, regToRead, bufferRxData, numberOfBytes);
+	}
 
-	/*Activamos el envio de ACK*/
-	i2c_send_ack(pHandlerI2C);
+	return status;
+}
+
+/*
+ * Retorna eI2C_STATUS_OK (0) si todo salió bien, o el código del error.
+ * */
+uint8_t i2c_WriteSingleRegister(I2C_Handler_t *pHandlerI2C, uint8_t regToWrite, uint8_t newValue){
+	return i2c_WriteManyRegisters(pHandlerI2C, regToWrite, &newValue, 1);
+}
 
-	/*8. Leemos el dato que envía el esclavo*/
-	while(numberOfBytes > 0){
-		//Cuando numberOfBytes es igual a 1, significa que es el último y hay que parar
-		if(numberOfBytes == 1){
-			/*6. Generamos la condición de NOAck, para que el Master no responda y el slave solo envie 1 byte*/
-			i2c_send_no_ack(pHandlerI2C);
+/*
+ * Retorna eI2C_STATUS_OK (0) si todo salió bien, o el código del error.
+ * */
+uint8_t i2c_WriteManyRegisters(I2C_Handler_t *pHandlerI2C, uint8_t regToWrite, uint8_t *bufferRxData, uint8_t numberOfBytes){
 
-			/*7. Generamos la condición de stop, para que el slave se detenga después de 1 byte*/
-			i2c_send_close_comm(pHandlerI2C);
+	uint8_t status = eI2C_STATUS_OK;
+	uint8_t *pFirstData = bufferRxData;
+	uint8_t totalBytes  = numberOfBytes;
 
-			*bufferRxData = i2c_read_byte(pHandlerI2C);
+	/*0. Si el dispositivo ya tiene esos valores no es necesario escribirlos*/
+	if(i2c_cache_write_is_redundant(pHandlerI2C, regToWrite, bufferRxData, numberOfBytes)){
+		pHandlerI2C->i2c_status = eI2C_STATUS_OK;
+		return eI2C_STATUS_OK;
+	}
+
+	/*0. El bus no se puede usar mientras el motor no bloqueante tenga transacciones*/
+	if(!i2c_IsIdle(pHandlerI2C)){
+		pHandlerI2C->i2c_status = eI2C_STATUS_BUSY;
+		return eI2C_STATUS_BUSY;
+	}
+
+	/*1. Generamos la condición de start*/
+	status = i2c_start_signal(pHandlerI2C);
+
+	/*2. Enviamos la dirección del esclavo y la indiciación de ESCRIBIR*/
+	if(status == eI2C_STATUS_OK){
+		status = i2c_send_slave_address_rw(pHandlerI2C, eI2C_WRITE_DATA);
+	}
+
+	/*3. Enviamos la dirección de memoria que deseamos escribir*/
+	if(status == eI2C_STATUS_OK){
+		i2c_clear_address_flag(pHandlerI2C);
+		status = i2c_send_memory_address(pHandlerI2C, regToWrite);
+	}
+
+	while((status == eI2C_STATUS_OK) && (numberOfBytes > 0)){
+
+		/*4. Enviamos el valor que deseamos escribir en el registro seleccionado*/
+		status = i2c_send_byte(pHandlerI2C, *bufferRxData);
+		bufferRxData++;
+		numberOfBytes--;
+	}
+
+	/*5. Generamos la condición stop, para que el slave se detenga después del último byte*/
+	if(status == eI2C_STATUS_OK){
+		status = i2c_send_close_comm(pHandlerI2C);
+	}
+
+	status = i2c_end_transaction(pHandlerI2C, status);
+
+	/*6. Write-through: el caché queda igual al dispositivo*/
+	if(status == eI2C_STATUS_OK){
+		i2c_cache_update(pHandlerI2C, regToWrite, pFirstData, totalBytes);
+	}
+
+	return status;
+}
+
+/*
+ * Asocia un caché de registros al dispositivo. El caché comienza vacío: cada registro
+ * se conoce con la primera lectura o escritura.
+ */
+void i2c_AttachCache(I2C_Handler_t *pHandlerI2C, I2C_RegCache_t *pRegCache){
+
+	if(pRegCache->regCount > I2C_CACHE_MAX_REGS){
+		pRegCache->regCount = I2C_CACHE_MAX_REGS;
+	}
+	pRegCache->validMask    = 0;
+	pRegCache->elidedWrites = 0;
+	pRegCache->cachedReads  = 0;
+
+	pHandlerI2C->pRegCache = pRegCache;
+}
+
+/* Olvida todos los valores guardados (por ejemplo después de un reset del dispositivo) */
+void i2c_InvalidateCache(I2C_Handler_t *pHandlerI2C){
+
+	if(pHandlerI2C->pRegCache != 0){
+		pHandlerI2C->pRegCache->validMask = 0;
+	}
+}
+
+/* Posición del registro en el mapa del caché, o -1 si es volátil */
+static int8_t i2c_cache_index(I2C_RegCache_t *pRegCache, uint8_t regAddress){
+
+	uint8_t index = 0;
+
+	for(index = 0; index < pRegCache->regCount; index++){
+		if(pRegCache->pRegMap[index] == regAddress){
+			return index;
 		}
+	}
+	return -1;
+}
 
-		/*Si no es el último, entonces captura el valor, incrementa el puntero y se reduce en 1*/
-		else{
-			*bufferRxData = i2c_read_byte(pHandlerI2C);
-			bufferRxData++;
+/*
+ * Si todos los registros pedidos son cacheables y conocidos, los copia en pData y retorna 1.
+ * Con un solo registro volátil o desconocido en el rango se retorna 0 (se lee todo del bus).
+ */
+static uint8_t i2c_cache_read(I2C_Handler_t  *pHandlerI2C, uint8_t regToRead, uint8_t *pData, uint8_t numberOfBytes){
+
+	I2C_RegCache_t *pRegCache = pHandlerI2C->pRegCache;
+	uint8_t index = 0;
+	int8_t  position = 0;
+
+	if(pRegCache == 0){
+		return 0;
+	}
+
+	for(index = 0; index < numberOfBytes; index++){
+		position = i2c_cache_index(pRegCache, regToRead + index);
+		if((position < 0) || !(pRegCache->validMask & (1UL << position))){
+			return 0;
 		}
+	}
 
-		/*Reducimos en 1 el conteo de los bytes a recibir*/
-		numberOfBytes--;
+	for(index = 0; index < numberOfBytes; index++){
+		pData[index] = pRegCache->values[i2c_cache_index(pRegCache, regToRead + index)];
+	}
+	pRegCache->cachedReads++;
+
+	return 1;
+}
+
+/* Retorna 1 si todos los registros del rango son cacheables, conocidos y ya tienen esos valores */
+static uint8_t i2c_cache_write_is_redundant(I2C_Handler_t  *pHandlerI2C, uint8_t regToWrite, uint8_t *pData, uint8_t numberOfBytes){
+
+	I2C_RegCache_t *pRegCache = pHandlerI2C->pRegCache;
+	uint8_t index = 0;
+	int8_t  position = 0;
+
+	if((pRegCache == 0) || (numberOfBytes == 0)){
+		return 0;
+	}
+
+	for(index = 0; index < numberOfBytes; index++){
+		position = i2c_cache_index(pRegCache, regToWrite + index);
+		if((position < 0) || !(pRegCache->validMask & (1UL << position)) ||
+				(pRegCache->values[position] != pData[index])){
+			return 0;
+		}
+	}
+	pRegCache->elidedWrites++;
+
+	return 1;
+}
+
+/* Guarda en el caché los registros cacheables de una transacción exitosa */
+static void i2c_cache_update(I2C_Handler_t  *pHandlerI2C, uint8_t regAddress, uint8_t *pData, uint8_t numberOfBytes){
+
+	I2C_RegCache_t *pRegCache = pHandlerI2C->pRegCache;
+	uint8_t index = 0;
+	int8_t  position = 0;
+
+	if(pRegCache == 0){
+		return;
 	}
 
-	return numberOfBytes;
+	for(index = 0; index < numberOfBytes; index++){
+		position = i2c_cache_index(pRegCache, regAddress + index);
+		if(position >= 0){
+			pRegCache->values[position] = pData[index];
+			pRegCache->validMask |= (1UL << position);
+		}
+	}
+}
+
+/*====== Transacciones no bloqueantes ======*/
+
+/*
+ * Encola una transacción en la cola de la clase de prioridad de su cliente. Si el periférico
+ * está libre la transacción comienza de inmediato; todo lo demás ocurre en los ISR de
+ * eventos/errores y al terminar se llama el callback del descriptor.
+ * Retorna eI2C_STATUS_PENDING, o eI2C_STATUS_QUEUE_FULL si no hay espacio.
+ * Una lectura con length = 0 (o sin buffer) se rechaza con eI2C_STATUS_BUS_ERROR.
+ * */
+uint8_t i2c_SubmitTransaction(I2C_Handler_t *pHandlerI2C, I2C_Transaction_t *pTransaction){
+	return i2c_SubmitBatch(pHandlerI2C, pTransaction, 1);
+}
+
+/*
+ * Encola count transacciones consecutivas del arreglo pTransactions, todas en la clase de
+ * prioridad de la primera. Se encolan todas o ninguna, y quedan seguidas en la cola: un
+ * grupo de lecturas periódicas (por ejemplo todos los sensores de un ciclo de muestreo)
+ * solo puede esperar a la transacción que esté en curso, nunca a las de clases más bajas.
+ * */
+uint8_t i2c_SubmitBatch(I2C_Handler_t *pHandlerI2C, I2C_Transaction_t *pTransactions, uint8_t count){
+
+	I2C_Engine_t *pEngine = i2c_get_engine(pHandlerI2C->pI2Cx);
+	uint8_t  priority = 0;
+	uint8_t  index    = 0;
+	uint32_t auxCycle = deadline_GetCycles();
+
+	if((pEngine == 0) || (count == 0) || (pEngine->pSlave != 0)){
+		return eI2C_STATUS_BUS_ERROR;
+	}
+
+	/* Una lectura sin datos no tiene secuencia de recepción (la máquina de estados
+	 * daría ACK sin fin y escribiría fuera del buffer): se rechaza todo el lote */
+	for(index = 0; index < count; index++){
+		if((pTransactions[index].direction == eI2C_READ_DATA) &&
+		   ((pTransactions[index].length == 0) || (pTransactions[index].pData == 0))){
+			return eI2C_STATUS_BUS_ERROR;
+		}
+	}
+
+	priority = i2c_transaction_priority(&pTransactions[0]);
+
+	__disable_irq();
+
+	if(i2c_queue_free(pEngine, priority) < count){
+		__enable_irq();
+		for(index = 0; index < count; index++){
+			pTransactions[index].status = eI2C_STATUS_QUEUE_FULL;
+		}
+		return eI2C_STATUS_QUEUE_FULL;
+	}
+
+	for(index = 0; index < count; index++){
+		pTransactions[index].status      = eI2C_STATUS_PENDING;
+		pTransactions[index].submitCycle = auxCycle;
+		i2c_queue_push(pEngine, priority, &pTransactions[index]);
+	}
+
+	if(pEngine->state == eI2C_STATE_IDLE){
+		i2c_engine_start_next(pEngine);
+	}
+
+	__enable_irq();
+
+	return eI2C_STATUS_PENDING;
+}
+
+/* Borra las estadísticas de latencia de un cliente */
+void i2c_ResetClientStats(I2C_Client_t *pClient){
+
+	__disable_irq();
+	pClient->stats.completed      = 0;
+	pClient->stats.errors         = 0;
+	pClient->stats.lastLatencyUs  = 0;
+	pClient->stats.maxLatencyUs   = 0;
+	pClient->stats.totalLatencyUs = 0;
+	__enable_irq();
+}
+
+/* Retorna 1 si no hay transacciones en curso ni en cola */
+uint8_t i2c_IsIdle(I2C_Handler_t *pHandlerI2C){
+
+	I2C_Engine_t *pEngine = i2c_get_engine(pHandlerI2C->pI2Cx);
+
+	return (pEngine == 0) || (pEngine->state == eI2C_STATE_IDLE);
+}
+
+/*
+ * Asigna los streams del DMA1 al periférico. Desde este momento las transacciones no
+ * bloqueantes con I2C_DMA_MIN_LENGTH bytes o más mueven los datos con el DMA:
+ * - Escritura: el DMA atiende TXE; al terminar, el evento BTF genera el STOP.
+ * - Lectura: con LAST = 1 el hardware envía el NACK del último byte por sí solo, y el
+ *   STOP se genera en la interrupción de transferencia completa del DMA.
+ * La CPU solo interviene en el START, la dirección y el final de la transacción.
+ * Retorna eI2C_STATUS_OK, o eI2C_STATUS_DMA_IN_USE si el otro periférico ya tiene el
+ * Stream7 (I2C1 e I2C2); en ese caso el periférico sigue trabajando por interrupciones.
+ * */
+uint8_t i2c_ConfigDma(I2C_Handler_t *pHandlerI2C){
+
+	uint8_t index = 0;
+	uint8_t other = 0;
+
+	for(index = 0; index < I2C_INSTANCES; index++){
+		if(i2cEngine[index].pI2Cx == pHandlerI2C->pI2Cx){
+			break;
+		}
+	}
+
+	if(index >= I2C_INSTANCES){
+		return eI2C_STATUS_BUS_ERROR;
+	}
+
+	/* Reprogramar el CHSEL del stream compartido le quitaría el DMA al otro periférico */
+	for(other = 0; other < I2C_INSTANCES; other++){
+		if((other != index) && i2cEngine[other].dmaEnabled &&
+		   (i2cDmaTxStream[other] == i2cDmaTxStream[index])){
+			return eI2C_STATUS_DMA_IN_USE;
+		}
+	}
+
+	i2c_config_dma_stream(&i2cEngine[index].dmaRx, i2cDmaRxStream[index],
+			i2cDmaRxChannel[index], DMA_DIR_PERIPH_TO_MEM);
+	i2c_config_dma_stream(&i2cEngine[index].dmaTx, i2cDmaTxStream[index],
+			i2cDmaTxChannel[index], DMA_DIR_MEM_TO_PERIPH);
+
+	i2cEngine[index].dmaEnabled = 1;
+
+	return eI2C_STATUS_OK;
+}
+
+/* DR (8 bit) <-> buffer (8 bit), modo normal, con interrupción de transferencia completa */
+static void i2c_config_dma_stream(DMA_Handler_t *pDMAHandler, DMA_Stream_TypeDef *pStream, uint8_t channel, uint8_t direction){
+
+	pDMAHandler->pStream                   = pStream;
+	pDMAHandler->config.channel            = channel;
+	pDMAHandler->config.direction          = direction;
+	pDMAHandler->config.periphDataSize     = DMA_DATASIZE_8BIT;
+	pDMAHandler->config.memDataSize        = DMA_DATASIZE_8BIT;
+	pDMAHandler->config.periphIncrement    = DMA_INCREMENT_DISABLE;
+	pDMAHandler->config.memIncrement       = DMA_INCREMENT_ENABLE;
+	pDMAHandler->config.mode               = DMA_MODE_NORMAL;
+	pDMAHandler->config.priority           = DMA_PRIORITY_HIGH;
+	pDMAHandler->config.interruptHalf      = DMA_INT_DISABLE;
+	pDMAHandler->config.interruptComplete  = DMA_INT_ENABLE;
+
+	dma_Config(pDMAHandler);
 }
 
 /**/
-void i2c_WriteSingleRegister(I2C_Handler_t *pHandlerI2C, uint8_t regToWrite, uint8_t newValue){
+static void i2c_config_interrupt(I2C_Handler_t *pHandlerI2C){
 
-	/*1. Generamos la condición de start*/
-	i2c_start_signal(pHandlerI2C);
+	uint8_t index = 0;
 
-	/*2. Enviamos la dirección del esclavo y la indiciación de ESCRIBIR*/
-	i2c_send_slave_address_rw(pHandlerI2C, eI2C_WRITE_DATA);
+	for(index = 0; index < I2C_INSTANCES; index++){
+		if(i2cEngine[index].pI2Cx == pHandlerI2C->pI2Cx){
+			NVIC_EnableIRQ(i2cEventIRQn[index]);
+			NVIC_EnableIRQ(i2cErrorIRQn[index]);
+		}
+	}
+}
 
-	/*3. Enviamos la dirección de memoria que deseamos escribir*/
-	i2c_send_memory_address(pHandlerI2C, regToWrite);
+/**/
+static I2C_Engine_t *i2c_get_engine(I2C_TypeDef *pI2Cx){
+
+	uint8_t index = 0;
+
+	for(index = 0; index < I2C_INSTANCES; index++){
+		if(i2cEngine[index].pI2Cx == pI2Cx){
+			return &i2cEngine[index];
+		}
+	}
+	return 0;
+}
 
-	/*4. Enviamos el valor que deseamos escribir en el registro seleccionado*/
-	i2c_send_byte(pHandlerI2C, newValue);
+/* Clase de prioridad de una transacción (normal si no tiene cliente) */
+static uint8_t i2c_transaction_priority(I2C_Transaction_t *pTransaction){
 
-	/*5. Generamos la condición de stop, para que el slave se detenga después de 1 byte*/
-	i2c_send_close_comm(pHandlerI2C);
+	if((pTransaction->pClient == 0) || (pTransaction->pClient->priority >= eI2C_PRIORITY_COUNT)){
+		return eI2C_PRIORITY_NORMAL;
+	}
+	return pTransaction->pClient->priority;
+}
+
+/* Espacios libres en la cola de una clase (un espacio queda vacío para distinguir llena de vacía) */
+static uint8_t i2c_queue_free(I2C_Engine_t *pEngine, uint8_t priority){
+	return (I2C_QUEUE_SIZE - 1 + pEngine->queueTail[priority] - pEngine->queueHead[priority]) % I2C_QUEUE_SIZE;
 }
 
 /**/
-void i2c_WriteManyRegisters(I2C_Handler_t *pHandlerI2C, uint8_t regToWrite, uint8_t *bufferRxData, uint8_t numberOfBytes){
+static void i2c_queue_push(I2C_Engine_t *pEngine, uint8_t priority, I2C_Transaction_t *pTransaction){
 
-	/*1. Generamos la condición de start*/
-	i2c_start_signal(pHandlerI2C);
+	pEngine->queue[priority][pEngine->queueHead[priority]] = pTransaction;
+	pEngine->queueHead[priority] = (pEngine->queueHead[priority] + 1) % I2C_QUEUE_SIZE;
+}
 
-	/*2. Enviamos la dirección del esclavo y la indiciación de ESCRIBIR*/
-	i2c_send_slave_address_rw(pHandlerI2C, eI2C_WRITE_DATA);
+/* Latencia desde que se encoló hasta que terminó, acumulada en el cliente */
+static void i2c_update_client_stats(I2C_Transaction_t *pTransaction, uint8_t status){
 
-	/*3. Enviamos la dirección de memoria que deseamos escribir*/
-	i2c_send_memory_address(pHandlerI2C, regToWrite);
+	I2C_ClientStats_t *pStats = 0;
+	uint32_t latencyUs = 0;
 
-	while(numberOfBytes > 0){
+	if(pTransaction->pClient == 0){
+		return;
+	}
 
-		/*4. Enviamos el valor que deseamos escribir en el registro seleccionado*/
-		i2c_send_byte(pHandlerI2C, *bufferRxData);
-		bufferRxData++;
-		numberOfBytes--;
+	pStats    = &pTransaction->pClient->stats;
+	latencyUs = deadline_CyclesToUs(deadline_GetCycles() - pTransaction->submitCycle);
+
+	pStats->completed++;
+	if(status != eI2C_STATUS_OK){
+		pStats->errors++;
+	}
+	pStats->lastLatencyUs   = latencyUs;
+	pStats->totalLatencyUs += latencyUs;
+	if(latencyUs > pStats->maxLatencyUs){
+		pStats->maxLatencyUs = latencyUs;
+	}
+}
+
+/*
+ * Toma la siguiente transacción de la cola y genera el START. Si la cola está vacía
+ * apaga las interrupciones del periférico, dejándolo libre para el modo bloqueante.
+ * */
+static void i2c_engine_start_next(I2C_Engine_t *pEngine){
+
+	uint8_t priority = 0;
+
+	/* La clase más alta que tenga transacciones en cola */
+	while((priority < eI2C_PRIORITY_COUNT) && (pEngine->queueTail[priority] == pEngine->queueHead[priority])){
+		priority++;
+	}
+
+	if(priority == eI2C_PRIORITY_COUNT){
+		pEngine->pCurrent = 0;
+		pEngine->state    = eI2C_STATE_IDLE;
+		pEngine->pI2Cx->CR2 &= ~(I2C_CR2_ITEVTEN | I2C_CR2_ITERREN | I2C_CR2_ITBUFEN);
+		return;
 	}
 
-	/*5. Generamos la condición stop, para que el slave se detenga después de 1 byte*/
-	i2c_send_close_comm(pHandlerI2C);
+	pEngine->pCurrent = pEngine->queue[priority][pEngine->queueTail[priority]];
+	pEngine->queueTail[priority] = (pEngine->queueTail[priority] + 1) % I2C_QUEUE_SIZE;
+	pEngine->dataIndex = 0;
+	pEngine->remaining = pEngine->pCurrent->length;
+
+	i2c_engine_launch(pEngine);
 }
 
+/*
+ * Genera el START de la transacción actual. Mientras el bit STOP de la anterior siga en 1
+ * no se puede escribir el CR1 (el STOP sale al terminar el byte en curso, hasta ~90 us a
+ * 100 kHz), y en modo maestro no hay un evento que avise cuando sale. En lugar de esperar
+ * aquí (esta función corre en los ISR y con las interrupciones apagadas en el submit),
+ * se pide por software la interrupción de eventos del periférico y se vuelve a intentar
+ * en ella; entre un intento y otro se atienden las demás interrupciones.
+ * */
+static void i2c_engine_launch(I2C_Engine_t *pEngine){
+
+	if(pEngine->pI2Cx->CR1 & I2C_CR1_STOP){
+		pEngine->state = eI2C_STATE_WAIT_STOP;
+		NVIC_SetPendingIRQ(i2cEventIRQn[pEngine - i2cEngine]);
+		return;
+	}
+
+	pEngine->state = eI2C_STATE_START_WRITE;
+
+	pEngine->pI2Cx->CR1 &= ~I2C_CR1_POS;
+	pEngine->pI2Cx->CR2 &= ~I2C_CR2_ITBUFEN;
+	pEngine->pI2Cx->CR2 |= I2C_CR2_ITEVTEN | I2C_CR2_ITERREN;
+	pEngine->pI2Cx->CR1 |= I2C_CR1_START;
+}
+
+/* Termina la transacción actual, llama su callback y continúa con la cola */
+static void i2c_engine_finish(I2C_Engine_t *pEngine, uint8_t status){
+
+	I2C_Transaction_t *pDone = pEngine->pCurrent;
+
+	/* Si la transacción terminó por error en medio de un DMA, se detiene el stream */
+	if(pEngine->pI2Cx->CR2 & I2C_CR2_DMAEN){
+		dma_StopTransfer(&pEngine->dmaRx);
+		dma_StopTransfer(&pEngine->dmaTx);
+	}
+
+	pEngine->pI2Cx->CR2 &= ~(I2C_CR2_ITBUFEN | I2C_CR2_DMAEN | I2C_CR2_LAST);
+	pEngine->pI2Cx->CR1 &= ~I2C_CR1_POS;
+
+	pDone->status = status;
+	i2c_update_client_stats(pDone, status);
+
+	/* Se lanza la siguiente antes del callback, para que el bus no espere a la aplicación */
+	i2c_engine_start_next(pEngine);
+
+	if(pDone->callback != 0){
+		pDone->callback(pDone->pContext, status);
+	}
+}
+
+/*
+ * Máquina de estados de los eventos (EV5, EV6, EV7, EV8_2 de las figuras 164 y 165).
+ * En transmisión se usa BTF (un byte a la vez); en recepción se usan las mismas secuencias
+ * N = 1, N = 2 y N > 2 de i2c_receive_bytes().
+ * */
+static void i2c_engine_event(I2C_Engine_t *pEngine){
+
+	I2C_TypeDef       *pI2Cx = pEngine->pI2Cx;
+	I2C_Transaction_t *pTr   = pEngine->pCurrent;
+	uint32_t auxSR1 = pI2Cx->SR1;
+	uint32_t auxSR2 = 0;
+	(void) auxSR2;
+
+	if(pEngine->pSlave != 0){
+		i2c_slave_event(pEngine);
+		return;
+	}
+
+	if(pTr == 0){
+		return;
+	}
+
+	switch(pEngine->state){
+
+	case eI2C_STATE_WAIT_STOP: {
+		/* Interrupción pedida por i2c_engine_launch(): nuevo intento del START */
+		i2c_engine_launch(pEngine);
+		break;
+	}
+
+	case eI2C_STATE_START_WRITE: {
+		if(auxSR1 & I2C_SR1_SB){
+			pI2Cx->DR = (pTr->slaveAddress << 1) | eI2C_WRITE_DATA;
+			pEngine->state = eI2C_STATE_ADDR_WRITE;
+		}
+		break;
+	}
+
+	case eI2C_STATE_ADDR_WRITE: {
+		if(auxSR1 & I2C_SR1_ADDR){
+			auxSR2 = pI2Cx->SR2;
+			pI2Cx->DR = pTr->regAddress;
+			pEngine->state = eI2C_STATE_SEND_REG;
+		}
+		break;
+	}
+
+	case eI2C_STATE_SEND_REG:
+	case eI2C_STATE_SEND_DATA: {
+		if(auxSR1 & I2C_SR1_BTF){
+			if(pTr->direction == eI2C_READ_DATA){
+				/* Restart para cambiar a lectura */
+				pI2Cx->CR1 |= I2C_CR1_START;
+				pEngine->state = eI2C_STATE_START_READ;
+			}
+			else if((pEngine->state == eI2C_STATE_SEND_REG) && pEngine->dmaEnabled &&
+					(pTr->length >= I2C_DMA_MIN_LENGTH)){
+				/* El DMA escribe todos los datos; los eventos se apagan hasta que termine */
+				pEngine->dataIndex = pTr->length;
+				pEngine->state     = eI2C_STATE_DMA_TX;
+				pI2Cx->CR2 &= ~I2C_CR2_ITEVTEN;
+				dma_StartTransfer(&pEngine->dmaTx, (uint32_t)&pI2Cx->DR, (uint32_t)pTr->pData, 0, pTr->length);
+				pI2Cx->CR2 |= I2C_CR2_DMAEN;
+			}
+			else if(pEngine->dataIndex < pTr->length){
+				pI2Cx->DR = pTr->pData[pEngine->dataIndex++];
+				pEngine->state = eI2C_STATE_SEND_DATA;
+			}
+			else{
+				pI2Cx->CR1 |= I2C_CR1_STOP;
+				i2c_engine_finish(pEngine, eI2C_STATUS_OK);
+			}
+		}
+		break;
+	}
+
+	case eI2C_STATE_START_READ: {
+		if(auxSR1 & I2C_SR1_SB){
+			pI2Cx->DR = (pTr->slaveAddress << 1) | eI2C_READ_DATA;
+			pEngine->state = eI2C_STATE_ADDR_READ;
+		}
+		break;
+	}
+
+	case eI2C_STATE_ADDR_READ: {
+		if(auxSR1 & I2C_SR1_ADDR){
+			if(pEngine->dmaEnabled && (pEngine->remaining >= I2C_DMA_MIN_LENGTH)){
+				/* ACK para todos los bytes; con LAST el último recibe NACK automáticamente */
+				pI2Cx->CR1 |= I2C_CR1_ACK;
+				pI2Cx->CR2 &= ~I2C_CR2_ITEVTEN;
+				dma_StartTransfer(&pEngine->dmaRx, (uint32_t)&pI2Cx->DR, (uint32_t)pTr->pData, 0, pTr->length);
+				pI2Cx->CR2 |= I2C_CR2_DMAEN | I2C_CR2_LAST;
+				auxSR2 = pI2Cx->SR2;
+				pEngine->state = eI2C_STATE_DMA_RX;
+				break;
+			}
+
+			if(pEngine->remaining == 1){
+				pI2Cx->CR1 &= ~I2C_CR1_ACK;
+				auxSR2 = pI2Cx->SR2;
+				pI2Cx->CR1 |= I2C_CR1_STOP;
+				pI2Cx->CR2 |= I2C_CR2_ITBUFEN;
+			}
+			else if(pEngine->remaining == 2){
+				pI2Cx->CR1 &= ~I2C_CR1_ACK;
+				pI2Cx->CR1 |= I2C_CR1_POS;
+				auxSR2 = pI2Cx->SR2;
+			}
+			else{
+				pI2Cx->CR1 |= I2C_CR1_ACK;
+				auxSR2 = pI2Cx->SR2;
+				if(pEngine->remaining > 3){
+					pI2Cx->CR2 |= I2C_CR2_ITBUFEN;
+				}
+			}
+			pEngine->state = eI2C_STATE_RECEIVE;
+		}
+		break;
+	}
+
+	case eI2C_STATE_RECEIVE: {
+		if(pEngine->remaining == 1){
+			/* N = 1: el STOP ya se programó con ADDR */
+			if(auxSR1 & I2C_SR1_RXNE){
+				pTr->pData[pEngine->dataIndex++] = pI2Cx->DR;
+				i2c_engine_finish(pEngine, eI2C_STATUS_OK);
+			}
+		}
+		else if(pEngine->remaining == 2){
+			/* DataN-1 en el DR y DataN en el registro de desplazamiento */
+			if(auxSR1 & I2C_SR1_BTF){
+				pI2Cx->CR1 |= I2C_CR1_STOP;
+				pTr->pData[pEngine->dataIndex++] = pI2Cx->DR;
+				pTr->pData[pEngine->dataIndex++] = pI2Cx->DR;
+				i2c_engine_finish(pEngine, eI2C_STATUS_OK);
+			}
+		}
+		else if(pEngine->remaining == 3){
+			/* DataN-2 en el DR y DataN-1 en el registro de desplazamiento */
+			if(auxSR1 & I2C_SR1_BTF){
+				pI2Cx->CR1 &= ~I2C_CR1_ACK;
+				pTr->pData[pEngine->dataIndex++] = pI2Cx->DR;
+				pEngine->remaining = 2;
+			}
+		}
+		else{
+			if(auxSR1 & I2C_SR1_RXNE){
+				pTr->pData[pEngine->dataIndex++] = pI2Cx->DR;
+				pEngine->remaining--;
+
+				/* Los 3 últimos bytes se manejan con BTF */
+				if(pEngine->remaining == 3){
+					pI2Cx->CR2 &= ~I2C_CR2_ITBUFEN;
+				}
+			}
+		}
+		break;
+	}
+
+	default: {
+		break;
+	}
+	}
+}
+
+/*
+ * Errores del bus: se bajan las banderas (se limpian escribiendo 0), se libera el bus
+ * y la transacción termina con el estado correspondiente.
+ * */
+static void i2c_engine_error(I2C_Engine_t *pEngine){
+
+	I2C_TypeDef *pI2Cx = pEngine->pI2Cx;
+	uint32_t auxSR1 = pI2Cx->SR1;
+	uint8_t status  = eI2C_STATUS_BUS_ERROR;
+
+	if(pEngine->pSlave != 0){
+		i2c_slave_error(pEngine);
+		return;
+	}
+
+	pI2Cx->SR1 &= ~(I2C_SR1_AF | I2C_SR1_ARLO | I2C_SR1_BERR | I2C_SR1_OVR);
+
+	if(pEngine->pCurrent == 0){
+		return;
+	}
+
+	if(auxSR1 & I2C_SR1_AF){
+		/* El esclavo no respondió: liberamos el bus con STOP */
+		pI2Cx->CR1 |= I2C_CR1_STOP;
+		status = eI2C_STATUS_NACK;
+	}
+	else if(auxSR1 & I2C_SR1_ARLO){
+		/* El hardware ya pasó a modo esclavo y soltó el bus */
+		status = eI2C_STATUS_ARB_LOST;
+	}
+	else{
+		pI2Cx->CR1 |= I2C_CR1_STOP;
+	}
+
+	i2c_engine_finish(pEngine, status);
+}
+
+/*
+ * Transferencia completa (o error) de uno de los streams del I2C.
+ * - RX: todos los datos están en el buffer, el último con NACK: generamos el STOP.
+ * - TX: el último dato está en el DR; se vuelven a activar los eventos para que el
+ *   BTF del último byte genere el STOP (estado SEND_DATA con todos los datos enviados).
+ * */
+static void i2c_engine_dma(I2C_Engine_t *pEngine, DMA_Stream_TypeDef *pStream){
+
+	uint8_t auxFlags = dma_ReadFlags(pStream);
+
+	dma_ClearFlags(pStream, auxFlags);
+
+	if(pEngine->pCurrent == 0){
+		return;
+	}
+
+	if(auxFlags & DMA_FLAG_TEIF){
+		pEngine->pI2Cx->CR1 |= I2C_CR1_STOP;
+		i2c_engine_finish(pEngine, eI2C_STATUS_BUS_ERROR);
+	}
+	else if(auxFlags & DMA_FLAG_TCIF){
+		if(pEngine->state == eI2C_STATE_DMA_RX){
+			pEngine->pI2Cx->CR1 |= I2C_CR1_STOP;
+			pEngine->dataIndex = pEngine->pCurrent->length;
+			i2c_engine_finish(pEngine, eI2C_STATUS_OK);
+		}
+		else if(pEngine->state == eI2C_STATE_DMA_TX){
+			pEngine->pI2Cx->CR2 &= ~I2C_CR2_DMAEN;
+			pEngine->state = eI2C_STATE_SEND_DATA;
+			pEngine->pI2Cx->CR2 |= I2C_CR2_ITEVTEN;
+		}
+	}
+}
+
+/*====== Modo esclavo ======*/
+
+/*
+ * Configura el periférico como esclavo con la dirección propia ownAddress del archivo de
+ * registros (figura 161 y sección 18.3.2 del manual). El reloj (FREQ) se configura igual que
+ * en modo maestro con i2c_Config. Todo el trabajo ocurre en la interrupción de eventos:
+ * con el stretching del reloj activo, si el ISR se demora el maestro simplemente espera,
+ * y el programa principal nunca se detiene por el bus.
+ * */
+void i2c_ConfigSlave(I2C_Handler_t *pHandlerI2C, I2C_SlaveRegFile_t *pRegFile){
+
+	I2C_Engine_t *pEngine = i2c_get_engine(pHandlerI2C->pI2Cx);
+
+	if(pEngine == 0){
+		return;
+	}
+
+	/*1. Reloj y velocidad como en modo maestro*/
+	i2c_Config(pHandlerI2C);
+
+	/*2. Estado inicial del archivo de registros*/
+	pRegFile->frontIndex   = 0;
+	pRegFile->pendingSwap  = 0;
+	pRegFile->busy         = 0;
+	pRegFile->regPointer   = 0;
+	pRegFile->txPointer    = 0;
+	pRegFile->transmitting = 0;
+	pRegFile->firstByte    = 0;
+	pRegFile->readCount    = 0;
+
+	__disable_irq();
+	pEngine->pSlave = pRegFile;
+
+	/*3. Dirección propia de 7 bits (el bit 14 del OAR1 siempre se debe mantener en 1)*/
+	pHandlerI2C->pI2Cx->OAR1 = (1 << 14) | ((uint32_t)pRegFile->ownAddress << 1);
+
+	/*4. El esclavo responde con ACK a su dirección y a cada byte recibido*/
+	pHandlerI2C->pI2Cx->CR1 |= I2C_CR1_ACK;
+
+	/*5. Eventos, errores y buffer (TXE/RXNE)*/
+	pHandlerI2C->pI2Cx->CR2 |= I2C_CR2_ITEVTEN | I2C_CR2_ITERREN | I2C_CR2_ITBUFEN;
+	__enable_irq();
+}
+
+/*
+ * Buffer que la aplicación puede llenar con la siguiente publicación.
+ * Retorna 0 si la publicación anterior aún espera que el maestro termine de leer; en ese
+ * caso la aplicación continúa midiendo y actualiza el archivo en su siguiente ciclo.
+ */
+uint8_t *i2c_SlaveGetWriteBuffer(I2C_SlaveRegFile_t *pRegFile){
+
+	if(pRegFile->pendingSwap){
+		return 0;
+	}
+	return pRegFile->pBuffer[pRegFile->frontIndex ^ 1];
+}
+
+/* Publica el buffer llenado: pasa a ser el que lee el maestro */
+void i2c_SlavePublish(I2C_SlaveRegFile_t *pRegFile){
+
+	__disable_irq();
+	if(pRegFile->busy){
+		pRegFile->pendingSwap = 1;
+	}
+	else{
+		pRegFile->frontIndex ^= 1;
+	}
+	__enable_irq();
+}
+
+/*
+ * Eventos del esclavo (figuras 162 y 163):
+ * - ADDR: el maestro nos direccionó; TRA indica si va a leer (transmitimos) o a escribir.
+ * - RXNE: el primer byte escrito por el maestro es el registro inicial; los demás se descartan
+ *   (los registros son de solo lectura).
+ * - TXE: se envía el siguiente registro del buffer publicado (0xFF fuera del mapa).
+ * - STOPF: fin de la transacción. Se limpia leyendo SR1 y luego escribiendo CR1.
+ * */
+static void i2c_slave_event(I2C_Engine_t *pEngine){
+
+	I2C_TypeDef        *pI2Cx    = pEngine->pI2Cx;
+	I2C_SlaveRegFile_t *pRegFile = pEngine->pSlave;
+	uint32_t auxSR1 = pI2Cx->SR1;
+	uint32_t auxSR2 = 0;
+	uint8_t  auxData = 0;
+
+	if(auxSR1 & I2C_SR1_ADDR){
+		auxSR2 = pI2Cx->SR2;
+		pRegFile->busy = 1;
+
+		if(auxSR2 & I2C_SR2_TRA){
+			pRegFile->transmitting = 1;
+			pRegFile->txPointer    = pRegFile->regPointer;
+		}
+		else{
+			pRegFile->transmitting = 0;
+			pRegFile->firstByte    = 1;
+		}
+	}
+
+	if(auxSR1 & I2C_SR1_RXNE){
+		auxData = pI2Cx->DR;
+		if(pRegFile->firstByte){
+			pRegFile->regPointer = auxData;
+			pRegFile->firstByte  = 0;
+		}
+	}
+
+	if((auxSR1 & I2C_SR1_TXE) && pRegFile->transmitting){
+		if(pRegFile->txPointer < pRegFile->size){
+			pI2Cx->DR = pRegFile->pBuffer[pRegFile->frontIndex][pRegFile->txPointer];
+		}
+		else{
+			pI2Cx->DR = 0xFF;
+		}
+		pRegFile->txPointer++;
+	}
+
+	if(auxSR1 & I2C_SR1_STOPF){
+		pI2Cx->CR1 |= I2C_CR1_ACK;
+		i2c_slave_end_transaction(pRegFile);
+	}
+}
+
+/*
+ * En modo esclavo transmisor el maestro termina la lectura con un NACK (AF), que es el
+ * final normal de la transacción. Los demás errores también la terminan.
+ * */
+static void i2c_slave_error(I2C_Engine_t *pEngine){
+
+	pEngine->pI2Cx->SR1 &= ~(I2C_SR1_AF | I2C_SR1_ARLO | I2C_SR1_BERR | I2C_SR1_OVR);
+
+	i2c_slave_end_transaction(pEngine->pSlave);
+}
+
+/* Aplica la publicación que esperaba el final de la lectura */
+static void i2c_slave_end_transaction(I2C_SlaveRegFile_t *pRegFile){
+
+	if(pRegFile->busy && pRegFile->transmitting){
+		pRegFile->readCount++;
+	}
+
+	pRegFile->busy         = 0;
+	pRegFile->transmitting = 0;
+	pRegFile->firstByte    = 0;
+
+	if(pRegFile->pendingSwap){
+		pRegFile->frontIndex ^= 1;
+		pRegFile->pendingSwap = 0;
+	}
+}
+
+/* ISR de los streams del DMA1 usados por el I2C */
+void DMA1_Stream0_IRQHandler(void){
+	i2c_engine_dma(&i2cEngine[0], DMA1_Stream0);
+}
+
+void DMA1_Stream3_IRQHandler(void){
+	i2c_engine_dma(&i2cEngine[1], DMA1_Stream3);
+}
+
+void DMA1_Stream2_IRQHandler(void){
+	i2c_engine_dma(&i2cEngine[2], DMA1_Stream2);
+}
+
+void DMA1_Stream4_IRQHandler(void){
+	i2c_engine_dma(&i2cEngine[2], DMA1_Stream4);
+}
+
+/* Stream7 compartido por I2C1_TX (canal 1) e I2C2_TX (canal 7): el CHSEL dice de quién es */
+void DMA1_Stream7_IRQHandler(void){
+	if(((DMA1_Stream7->CR & DMA_SxCR_CHSEL) >> DMA_SxCR_CHSEL_Pos) == i2cDmaTxChannel[1]){
+		i2c_engine_dma(&i2cEngine[1], DMA1_Stream7);
+	}
+	else{
+		i2c_engine_dma(&i2cEngine[0], DMA1_Stream7);
+	}
+}
+
+/* ISR de eventos y errores de cada periférico I2C */
+void I2C1_EV_IRQHandler(void){
+	i2c_engine_event(&i2cEngine[0]);
+}
+
+void I2C1_ER_IRQHandler(void){
+	i2c_engine_error(&i2cEngine[0]);
+}
+
+void I2C2_EV_IRQHandler(void){
+	i2c_engine_event(&i2cEngine[1]);
+}
+
+void I2C2_ER_IRQHandler(void){
+	i2c_engine_error(&i2cEngine[1]);
+}
+
+void I2C3_EV_IRQHandler(void){
+	i2c_engine_event(&i2cEngine[2]);
+}
+
+void I2C3_ER_IRQHandler(void){
+	i2c_engine_error(&i2cEngine[2]);
+}
@@ -0,0 +1,282 @@
+/*
+ * logic_analyzer_driver_hal.c
+ *
+ *  Created on: 19/10/2026
+ *      Author: laurasofia
+ */
+
+#include "stm32f4xx.h"
+#include "stm32_assert.h"
+
+#include "logic_analyzer_driver_hal.h"
+#include "gpio_driver_hal.h"
+#include "dma_driver_hal.h"
+#include "rcc_driver_hal.h"
+
+/* Elementos que necesita internamente el driver */
+GPIO_Handler_t  handlerLATriggerPin = {0};
+DMA_Handler_t   handlerLADma        = {0};
+LA_Handler_t    *ptrLAUsed          = 0;
+
+/* === Headers for private functions === */
+static void la_config_timer(LA_Handler_t *pLAHandler);
+static void la_config_trigger(LA_Handler_t *pLAHandler);
+static void la_config_dma(void);
+static void la_send_halfword(USART_Handler_t *ptrUsartHandler, uint16_t data);
+static void la_send_word(USART_Handler_t *ptrUsartHandler, uint32_t data);
+static void la_finish_capture(void);
+
+/*
+ * Configura el TIM1, la entrada de trigger (PA8) y el DMA2 Stream5.
+ * La captura queda lista pero detenida, se inicia con la_Arm().
+ */
+void la_Config(LA_Handler_t *pLAHandler){
+
+	/* Guardamos la referencia para el ISR del DMA */
+	ptrLAUsed = pLAHandler;
+
+	/* Se cargan PSC = prescaler - 1 y ARR = period - 1: con 0 (valor del handler sin
+	 * inicializar) ambos quedarían en 0xFFFF. El prescaler mínimo es 1, y el periodo
+	 * mínimo es 2 porque con ARR = 0 el contador no avanza */
+	if(pLAHandler->config.prescaler == 0){
+		pLAHandler->config.prescaler = 1;
+	}
+	if(pLAHandler->config.period < 2){
+		pLAHandler->config.period = 2;
+	}
+
+	/* 1. Base de tiempo de muestreo */
+	la_config_timer(pLAHandler);
+
+	/* 2. Condición de disparo */
+	la_config_trigger(pLAHandler);
+
+	/* 3. Stream del DMA que copia el IDR en el buffer */
+	la_config_dma();
+
+	pLAHandler->state           = LA_STATE_IDLE;
+	pLAHandler->samplesCaptured = 0;
+}
+
+/*
+ * Arma la captura: carga el DMA y, según el trigger, arranca el timer o lo deja
+ * esperando la señal en PA8.
+ */
+void la_Arm(LA_Handler_t *pLAHandler){
+
+	/* Aseguramos que el timer está detenido mientras cargamos el DMA */
+	TIM1->CR1 &= ~TIM_CR1_CEN;
+	TIM1->CNT  = 0;
+	TIM1->SR   = 0;
+
+	pLAHandler->samplesCaptured = 0;
+	pLAHandler->state           = LA_STATE_ARMED;
+
+	/* Cada update del TIM1 mueve un half-word del IDR al buffer */
+	dma_StartTransfer(&handlerLADma, (uint32_t)&pLAHandler->config.pGPIOx->IDR,
+			(uint32_t)pLAHandler->config.pBuffer, 0, pLAHandler->config.bufferSize);
+
+	/* En modo trigger el hardware pone CEN en 1 con el flanco, en modo gated
+	 * el contador se habilita con CEN y el nivel de PA8 decide si cuenta */
+	if((pLAHandler->config.triggerMode == LA_TRIGGER_RISING_EDGE) ||
+	   (pLAHandler->config.triggerMode == LA_TRIGGER_FALLING_EDGE)){
+		__NOP();
+	}
+	else{
+		TIM1->CR1 |= TIM_CR1_CEN;
+	}
+}
+
+/*
+ * Detiene la captura antes de llenar el buffer. Las muestras ya tomadas quedan disponibles.
+ */
+void la_Stop(LA_Handler_t *pLAHandler){
+
+	if(pLAHandler->state == LA_STATE_ARMED){
+		la_finish_capture();
+	}
+}
+
+/**/
+uint8_t la_GetState(LA_Handler_t *pLAHandler){
+	return pLAHandler->state;
+}
+
+/*
+ * Envía la captura comprimida con run-length por el USART (formato descrito en el .h).
+ * Solo se comparan los pines de channelMask, por lo que los demás pines del puerto
+ * no rompen las secuencias.
+ */
+void la_DumpRLE(LA_Handler_t *pLAHandler, USART_Handler_t *ptrUsartHandler){
+
+	uint16_t auxValue  = 0;
+	uint16_t runValue  = 0;
+	uint16_t runLength = 0;
+	uint16_t index     = 0;
+
+	/* 1. Encabezado */
+	usart_WriteChar(ptrUsartHandler, LA_DUMP_SYNC_0);
+	usart_WriteChar(ptrUsartHandler, LA_DUMP_SYNC_1);
+	la_send_halfword(ptrUsartHandler, pLAHandler->config.channelMask);
+	la_send_word(ptrUsartHandler, rcc_GetTimerClock(RCC_BUS_APB2));
+	la_send_word(ptrUsartHandler, (uint32_t)pLAHandler->config.prescaler * pLAHandler->config.period);
+	la_send_halfword(ptrUsartHandler, pLAHandler->samplesCaptured);
+
+	/* 2. Registros RLE */
+	for(index = 0; index < pLAHandler->samplesCaptured; index++){
+
+		auxValue = pLAHandler->config.pBuffer[index] & pLAHandler->config.channelMask;
+
+		if((runLength != 0) && ((auxValue != runValue) || (runLength == 0xFFFF))){
+			la_send_halfword(ptrUsartHandler, runValue);
+			la_send_halfword(ptrUsartHandler, runLength);
+			runLength = 0;
+		}
+
+		runValue = auxValue;
+		runLength++;
+	}
+
+	if(runLength != 0){
+		la_send_halfword(ptrUsartHandler, runValue);
+		la_send_halfword(ptrUsartHandler, runLength);
+	}
+
+	/* 3. Registro de cierre */
+	la_send_halfword(ptrUsartHandler, 0);
+	la_send_halfword(ptrUsartHandler, 0);
+}
+
+/*
+ * TIM1 como base de tiempo: cada evento update pide un dato al DMA (UDE)
+ */
+static void la_config_timer(LA_Handler_t *pLAHandler){
+
+	RCC->APB2ENR |= RCC_APB2ENR_TIM1EN;
+
+	TIM1->CR1  = 0;
+	TIM1->SMCR = 0;
+	TIM1->DIER = 0;
+
+	TIM1->PSC = pLAHandler->config.prescaler - 1;
+	TIM1->ARR = pLAHandler->config.period - 1;
+
+	/* Forzamos un update para cargar el PSC y bajamos la bandera que esto genera */
+	TIM1->EGR = TIM_EGR_UG;
+	TIM1->SR  = 0;
+
+	/* Request al DMA en cada update */
+	TIM1->DIER |= TIM_DIER_UDE;
+}
+
+/*
+ * Configura PA8 (TIM1_CH1) como entrada TI1 y el modo esclavo del TIM1.
+ * SMCR: TS = 101 (TI1FP1), SMS = 110 (trigger) ó 101 (gated).
+ */
+static void la_config_trigger(LA_Handler_t *pLAHandler){
+
+	if(pLAHandler->config.triggerMode == LA_TRIGGER_IMMEDIATE){
+		return;
+	}
+
+	/* Pin de trigger en función alternativa AF1 */
+	handlerLATriggerPin.pGPIOx                         = GPIOA;
+	handlerLATriggerPin.pinConfig.GPIO_PinNumber       = PIN_8;
+	handlerLATriggerPin.pinConfig.GPIO_PinMode         = GPIO_MODE_ALTFN;
+	handlerLATriggerPin.pinConfig.GPIO_PinAltFunMode   = AF1;
+	handlerLATriggerPin.pinConfig.GPIO_PinPuPdControl  = GPIO_PUPDR_NOTHING;
+	handlerLATriggerPin.pinConfig.GPIO_PinOutputSpeed  = GPIO_OSPEED_HIGH;
+	handlerLATriggerPin.pinConfig.GPIO_PinOutputType   = GPIO_OTYPE_PUSHPULL;
+	gpio_Config(&handlerLATriggerPin);
+
+	/* CC1 como entrada mapeada en TI1 (CC1S = 01), sin filtro */
+	TIM1->CCER  &= ~TIM_CCER_CC1E;
+	TIM1->CCMR1 &= ~TIM_CCMR1_CC1S;
+	TIM1->CCMR1 |= (0b01 << TIM_CCMR1_CC1S_Pos);
+
+	/* Polaridad: flanco de bajada o nivel bajo se obtienen invirtiendo TI1FP1 */
+	if((pLAHandler->config.triggerMode == LA_TRIGGER_FALLING_EDGE) ||
+	   (pLAHandler->config.triggerMode == LA_TRIGGER_GATED_LOW)){
+		TIM1->CCER |= TIM_CCER_CC1P;
+	}
+	else{
+		TIM1->CCER &= ~TIM_CCER_CC1P;
+	}
+
+	/* Fuente de trigger TI1FP1 */
+	TIM1->SMCR |= (0b101 << TIM_SMCR_TS_Pos);
+
+	if((pLAHandler->config.triggerMode == LA_TRIGGER_GATED_HIGH) ||
+	   (pLAHandler->config.triggerMode == LA_TRIGGER_GATED_LOW)){
+		TIM1->SMCR |= (0b101 << TIM_SMCR_SMS_Pos);
+	}
+	else{
+		TIM1->SMCR |= (0b110 << TIM_SMCR_SMS_Pos);
+	}
+}
+
+/*
+ * DMA2 Stream5, canal 6 (TIM1_UP): IDR (16 bit) -> buffer (16 bit), modo normal.
+ * La interrupción de bloque completo detiene el timer.
+ */
+static void la_config_dma(void){
+
+	handlerLADma.pStream                   = DMA2_Stream5;
+	handlerLADma.config.channel            = DMA_CHANNEL_6;
+	handlerLADma.config.direction          = DMA_DIR_PERIPH_TO_MEM;
+	handlerLADma.config.periphDataSize     = DMA_DATASIZE_16BIT;
+	handlerLADma.config.memDataSize        = DMA_DATASIZE_16BIT;
+	handlerLADma.config.periphIncrement    = DMA_INCREMENT_DISABLE;
+	handlerLADma.config.memIncrement       = DMA_INCREMENT_ENABLE;
+	handlerLADma.config.mode               = DMA_MODE_NORMAL;
+	handlerLADma.config.priority           = DMA_PRIORITY_VERY_HIGH;
+	handlerLADma.config.interruptHalf      = DMA_INT_DISABLE;
+	handlerLADma.config.interruptComplete  = DMA_INT_ENABLE;
+
+	dma_Config(&handlerLADma);
+}
+
+/* Detiene el timer y el DMA, y calcula cuántas muestras alcanzaron a tomarse */
+static void la_finish_capture(void){
+
+	TIM1->CR1 &= ~TIM_CR1_CEN;
+	dma_StopTransfer(&handlerLADma);
+
+	ptrLAUsed->samplesCaptured = ptrLAUsed->config.bufferSize - dma_GetRemaining(&handlerLADma);
+	ptrLAUsed->state           = LA_STATE_DONE;
+}
+
+/**/
+static void la_send_halfword(USART_Handler_t *ptrUsartHandler, uint16_t data){
+	usart_WriteChar(ptrUsartHandler, data & 0xFF);
+	usart_WriteChar(ptrUsartHandler, (data >> 8) & 0xFF);
+}
+
+/**/
+static void la_send_word(USART_Handler_t *ptrUsartHandler, uint32_t data){
+	la_send_halfword(ptrUsartHandler, data & 0xFFFF);
+	la_send_halfword(ptrUsartHandler, (data >> 16) & 0xFFFF);
+}
+
+/**/
+__attribute__((weak)) void la_CaptureCompleteCallback(void){
+	__NOP();
+}
+
+/*
+ * ISR del DMA2 Stream5: el buffer se llenó (o hubo un error de transferencia)
+ */
+void DMA2_Stream5_IRQHandler(void){
+
+	uint8_t auxFlags = dma_ReadFlags(DMA2_Stream5);
+
+	/* Bajamos las banderas que se leyeron */
+	dma_ClearFlags(DMA2_Stream5, auxFlags);
+
+	if((auxFlags & (DMA_FLAG_TCIF | DMA_FLAG_TEIF)) && (ptrLAUsed != 0)){
+
+		la_finish_capture();
+
+		la_CaptureCompleteCallback();
+	}
+}
@@ -0,0 +1,237 @@
+/*
+ * mpu6050_driver_hal.c
+ *
+ *  Created on: 19/10/2026
+ *      Author: laurasofia
+ */
+
+#include "stm32f4xx.h"
+#include "stm32_assert.h"
+
+#include "mpu6050_driver_hal.h"
+#include "deadline_driver_hal.h"
+
+/* Frecuencia de salida del giroscopio: 8 kHz sin DLPF, 1 kHz con DLPF */
+#define MPU6050_GYRO_RATE_NO_DLPF    8000
+#define MPU6050_GYRO_RATE_DLPF       1000
+
+/* Tiempo que tarda el DEVICE_RESET del PWR_MGMT_1 */
+#define MPU6050_RESET_TIME_US        100000
+
+/* Sensibilidad del giroscopio x10 (LSB por grado/s): 131, 65.5, 32.8 y 16.4 */
+static const uint16_t mpuGyroSensitivityX10[4] = {1310, 655, 328, 164};
+
+/* === Headers for private functions === */
+static uint8_t mpu6050_write_register(MPU6050_Handler_t *pMpuHandler, uint8_t regToWrite, uint8_t newValue);
+static uint8_t mpu6050_read_registers(MPU6050_Handler_t *pMpuHandler, uint8_t regToRead, uint8_t *pData, uint8_t numberOfBytes);
+static void mpu6050_convert_sample(MPU6050_Handler_t *pMpuHandler, uint8_t *pRawData, MPU6050_Sample_t *pSample);
+
+/*
+ * Configuración del sensor:
+ * 1. Se verifica el WHO_AM_I
+ * 2. Reset del dispositivo y reloj del PLL (se sale del modo sleep)
+ * 3. Filtro digital y divisor de la tasa de muestreo
+ * 4. Rangos del giroscopio y del acelerómetro
+ * 5. FIFO con acelerómetro, temperatura y giroscopio (opcional)
+ */
+uint8_t mpu6050_Config(MPU6050_Handler_t *pMpuHandler){
+
+	uint8_t  whoAmI      = 0;
+	uint32_t gyroRate    = MPU6050_GYRO_RATE_DLPF;
+	uint32_t rateDivider = 0;
+	uint8_t  status      = MPU6050_OK;
+
+	pMpuHandler->overflowCount = 0;
+
+	/*1. Verificamos que sea un MPU-6050*/
+	if(mpu6050_read_registers(pMpuHandler, MPU6050_REG_WHO_AM_I, &whoAmI, 1) != MPU6050_OK){
+		return MPU6050_ERROR_BUS;
+	}
+	if((whoAmI & 0x7E) != MPU6050_WHO_AM_I_VALUE){
+		return MPU6050_ERROR_WHO_AM_I;
+	}
+
+	/*2. Reset de todos los registros, luego se despierta con el reloj del PLL*/
+	status |= mpu6050_write_register(pMpuHandler, MPU6050_REG_PWR_MGMT_1, 0x80);
+	deadline_DelayUs(MPU6050_RESET_TIME_US);
+	status |= mpu6050_write_register(pMpuHandler, MPU6050_REG_PWR_MGMT_1, MPU6050_PWR_MGMT_1_CLK_PLL_XG);
+
+	/*3. Sample Rate = Gyroscope Output Rate / (1 + SMPLRT_DIV)*/
+	if(pMpuHandler->dlpf == MPU6050_DLPF_260HZ){
+		gyroRate = MPU6050_GYRO_RATE_NO_DLPF;
+	}
+	if(pMpuHandler->sampleRateHz != 0){
+		rateDivider = (gyroRate + (pMpuHandler->sampleRateHz / 2)) / pMpuHandler->sampleRateHz;
+	}
+	if(rateDivider > 0){
+		rateDivider--;
+	}
+	if(rateDivider > 255){
+		rateDivider = 255;
+	}
+	status |= mpu6050_write_register(pMpuHandler, MPU6050_REG_CONFIG, pMpuHandler->dlpf & 0b111);
+	status |= mpu6050_write_register(pMpuHandler, MPU6050_REG_SMPLRT_DIV, (uint8_t)rateDivider);
+
+	/* Tasa real, después del redondeo del divisor */
+	pMpuHandler->sampleRateHz = gyroRate / (rateDivider + 1);
+
+	/*4. Rangos (bits 4:3 de GYRO_CONFIG y ACCEL_CONFIG)*/
+	status |= mpu6050_write_register(pMpuHandler, MPU6050_REG_GYRO_CONFIG, (pMpuHandler->gyroRange & 0b11) << 3);
+	status |= mpu6050_write_register(pMpuHandler, MPU6050_REG_ACCEL_CONFIG, (pMpuHandler->accelRange & 0b11) << 3);
+
+	/*5. FIFO*/
+	if(pMpuHandler->fifoEnable == MPU6050_FIFO_ENABLE){
+		status |= mpu6050_write_register(pMpuHandler, MPU6050_REG_FIFO_EN,
+				MPU6050_FIFO_EN_ACCEL | MPU6050_FIFO_EN_TEMP | MPU6050_FIFO_EN_XG | MPU6050_FIFO_EN_YG | MPU6050_FIFO_EN_ZG);
+		status |= mpu6050_ResetFifo(pMpuHandler);
+	}
+	else{
+		status |= mpu6050_write_register(pMpuHandler, MPU6050_REG_FIFO_EN, 0);
+		status |= mpu6050_write_register(pMpuHandler, MPU6050_REG_USER_CTRL, 0);
+	}
+
+	return (status == MPU6050_OK) ? MPU6050_OK : MPU6050_ERROR_BUS;
+}
+
+/*
+ * Lee la muestra más reciente (0x3B - 0x48) en una sola ráfaga de 14 bytes.
+ * El sensor congela los registros durante la ráfaga, así que todos los ejes son de la misma muestra.
+ */
+uint8_t mpu6050_ReadSample(MPU6050_Handler_t *pMpuHandler, MPU6050_Sample_t *pSample){
+
+	uint8_t rawData[MPU6050_SAMPLE_SIZE] = {0};
+
+	if(mpu6050_read_registers(pMpuHandler, MPU6050_REG_ACCEL_XOUT_H, rawData, MPU6050_SAMPLE_SIZE) != MPU6050_OK){
+		return MPU6050_ERROR_BUS;
+	}
+
+	mpu6050_convert_sample(pMpuHandler, rawData, pSample);
+
+	return MPU6050_OK;
+}
+
+/*
+ * Lee hasta maxSamples muestras de la FIFO. Retorna el número de muestras leídas.
+ * Se leen MPU6050_FIFO_BURST_SAMPLES muestras por transacción.
+ * Si la FIFO se desbordó, los datos ya no están alineados a 14 bytes: se reinicia
+ * y se cuenta en overflowCount.
+ */
+uint8_t mpu6050_ReadFifo(MPU6050_Handler_t *pMpuHandler, MPU6050_Sample_t *pSamples, uint8_t maxSamples){
+
+	uint8_t  rawData[MPU6050_FIFO_BURST_SAMPLES * MPU6050_SAMPLE_SIZE] = {0};
+	uint8_t  fifoCountData[2] = {0};
+	uint8_t  intStatus        = 0;
+	uint16_t fifoCount        = 0;
+	uint8_t  samplesRead      = 0;
+	uint8_t  burstSamples     = 0;
+	uint8_t  index            = 0;
+
+	/*1. Revisamos el desborde (INT_STATUS se limpia al leerlo)*/
+	if(mpu6050_read_registers(pMpuHandler, MPU6050_REG_INT_STATUS, &intStatus, 1) != MPU6050_OK){
+		return 0;
+	}
+	if(intStatus & MPU6050_INT_FIFO_OFLOW){
+		pMpuHandler->overflowCount++;
+		mpu6050_ResetFifo(pMpuHandler);
+		return 0;
+	}
+
+	/*2. Número de bytes en la FIFO (FIFO_COUNTH y FIFO_COUNTL)*/
+	if(mpu6050_read_registers(pMpuHandler, MPU6050_REG_FIFO_COUNTH, fifoCountData, 2) != MPU6050_OK){
+		return 0;
+	}
+	fifoCount = (fifoCountData[0] << 8) | fifoCountData[1];
+
+	/*3. Leemos las muestras completas en ráfagas*/
+	while((fifoCount >= MPU6050_SAMPLE_SIZE) && (samplesRead < maxSamples)){
+
+		burstSamples = fifoCount / MPU6050_SAMPLE_SIZE;
+		if(burstSamples > MPU6050_FIFO_BURST_SAMPLES){
+			burstSamples = MPU6050_FIFO_BURST_SAMPLES;
+		}
+		if(burstSamples > (maxSamples - samplesRead)){
+			burstSamples = maxSamples - samplesRead;
+		}
+
+		if(mpu6050_read_registers(pMpuHandler, MPU6050_REG_FIFO_R_W, rawData, burstSamples * MPU6050_SAMPLE_SIZE) != MPU6050_OK){
+			break;
+		}
+
+		for(index = 0; index < burstSamples; index++){
+			mpu6050_convert_sample(pMpuHandler, &rawData[index * MPU6050_SAMPLE_SIZE], &pSamples[samplesRead]);
+			samplesRead++;
+		}
+
+		fifoCount -= burstSamples * MPU6050_SAMPLE_SIZE;
+	}
+
+	return samplesRead;
+}
+
+/*
+ * Vacía la FIFO y la vuelve a activar
+ */
+uint8_t mpu6050_ResetFifo(MPU6050_Handler_t *pMpuHandler){
+
+	uint8_t status = MPU6050_OK;
+
+	status |= mpu6050_write_register(pMpuHandler, MPU6050_REG_USER_CTRL, 0);
+	status |= mpu6050_write_register(pMpuHandler, MPU6050_REG_USER_CTRL, MPU6050_USER_CTRL_FIFO_RESET);
+	status |= mpu6050_write_register(pMpuHandler, MPU6050_REG_USER_CTRL, MPU6050_USER_CTRL_FIFO_EN);
+
+	return (status == MPU6050_OK) ? MPU6050_OK : MPU6050_ERROR_BUS;
+}
+
+/*
+ * Convierte 14 bytes (big endian) a Q16.16:
+ * - Aceleración: sensibilidad 16384 / 2^range LSB/g, así que g(Q16.16) = raw * 4 * 2^range
+ * - Temperatura: T = raw / 340 + 36.53 (datasheet)
+ * - Giroscopio:  sensibilidad 131 / 2^range LSB/(grado/s), aproximada por la tabla
+ */
+static void mpu6050_convert_sample(MPU6050_Handler_t *pMpuHandler, uint8_t *pRawData, MPU6050_Sample_t *pSample){
+
+	int16_t  rawValue[7] = {0};
+	uint8_t  index       = 0;
+	int32_t  accelScale  = 4 << (pMpuHandler->accelRange & 0b11);
+	uint16_t gyroSensX10 = mpuGyroSensitivityX10[pMpuHandler->gyroRange & 0b11];
+
+	for(index = 0; index < 7; index++){
+		rawValue[index] = (int16_t)((pRawData[2 * index] << 8) | pRawData[(2 * index) + 1]);
+	}
+
+	pSample->accelX = rawValue[0] * accelScale;
+	pSample->accelY = rawValue[1] * accelScale;
+	pSample->accelZ = rawValue[2] * accelScale;
+
+	/* 36.53 * 65536 = 2394030 */
+	pSample->temperature = (((int32_t)rawValue[3] * 65536) / 340) + 2394030;
+
+	pSample->gyroX = (int32_t)(((int64_t)rawValue[4] * 655360) / gyroSensX10);
+	pSample->gyroY = (int32_t)(((int64_t)rawValue[5] * 655360) / gyroSensX10);
+	pSample->gyroZ = (int32_t)(((int64_t)rawValue[6] * 655360) / gyroSensX10);
+}
+
+/*
+ * El handler I2C puede ser compartido con otros sensores del bus, por lo que la
+ * dirección del esclavo se carga antes de cada transacción.
+ */
+static uint8_t mpu6050_write_register(MPU6050_Handler_t *pMpuHandler, uint8_t regToWrite, uint8_t newValue){
+
+	pMpuHandler->pI2CHandler->slaveAddress = pMpuHandler->address;
+
+	if(i2c_WriteSingleRegister(pMpuHandler->pI2CHandler, regToWrite, newValue) != eI2C_STATUS_OK){
+		return MPU6050_ERROR_BUS;
+	}
+	return MPU6050_OK;
+}
+
+/**/
+static uint8_t mpu6050_read_registers(MPU6050_Handler_t *pMpuHandler, uint8_t regToRead, uint8_t *pData, uint8_t numberOfBytes){
+
+	pMpuHandler->pI2CHandler->slaveAddress = pMpuHandler->address;
+
+	if(i2c_ReadManyRegisters(pMpuHandler->pI2CHandler, regToRead, pData, numberOfBytes) != eI2C_STATUS_OK){
+		return MPU6050_ERROR_BUS;
+	}
+	return MPU6050_OK;
+}
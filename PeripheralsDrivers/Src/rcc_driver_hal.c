@@ -0,0 +1,101 @@
+/*
+ * rcc_driver_hal.c
+ *
+ *  Created on: 19/10/2026
+ *      Author: laurasofia
+ */
+
+#include "stm32f4xx.h"
+#include "stm32_assert.h"
+
+#include "rcc_driver_hal.h"
+
+/* Desplazamiento del prescaler del AHB (HPRE): 0xxx -> /1, 1000 -> /2 ... 1111 -> /512 */
+static const uint8_t rccAhbShift[16] = {0, 0, 0, 0, 0, 0, 0, 0, 1, 2, 3, 4, 6, 7, 8, 9};
+
+/* Desplazamiento de los prescalers de los APB (PPRE1/PPRE2): 0xx -> /1, 100 -> /2 ... 111 -> /16 */
+static const uint8_t rccApbShift[8] = {0, 0, 0, 0, 1, 2, 3, 4};
+
+/* === Headers for private functions === */
+static uint32_t rcc_get_pll_clock(void);
+
+/*
+ * Frecuencia del SYSCLK según la fuente que el hardware reporta en SWS (HSI, HSE o PLL)
+ */
+uint32_t rcc_GetSysclk(void){
+
+	switch((RCC->CFGR & RCC_CFGR_SWS) >> RCC_CFGR_SWS_Pos){
+
+	case 0b01: {
+		return RCC_HSE_VALUE;
+	}
+	case 0b10: {
+		return rcc_get_pll_clock();
+	}
+	default: {
+		return RCC_HSI_VALUE;
+	}
+	}
+}
+
+/* Reloj del bus AHB (HCLK) */
+uint32_t rcc_GetHclk(void){
+	return rcc_GetSysclk() >> rccAhbShift[(RCC->CFGR & RCC_CFGR_HPRE) >> RCC_CFGR_HPRE_Pos];
+}
+
+/* Reloj del bus APB1 (I2C, USART2, TIM2-5), máximo 50 MHz */
+uint32_t rcc_GetPclk1(void){
+	return rcc_GetHclk() >> rccApbShift[(RCC->CFGR & RCC_CFGR_PPRE1) >> RCC_CFGR_PPRE1_Pos];
+}
+
+/* Reloj del bus APB2 (USART1/6, ADC, TIM1, TIM9-11) */
+uint32_t rcc_GetPclk2(void){
+	return rcc_GetHclk() >> rccApbShift[(RCC->CFGR & RCC_CFGR_PPRE2) >> RCC_CFGR_PPRE2_Pos];
+}
+
+/*
+ * Reloj de los timers del bus (RCC_BUS_APB1 o RCC_BUS_APB2). Si el APB tiene prescaler
+ * (PPREx >= 0b100) los timers reciben el doble del PCLK.
+ */
+uint32_t rcc_GetTimerClock(uint8_t bus){
+
+	uint32_t auxPpre = 0;
+	uint32_t auxPclk = 0;
+
+	if(bus == RCC_BUS_APB2){
+		auxPpre = (RCC->CFGR & RCC_CFGR_PPRE2) >> RCC_CFGR_PPRE2_Pos;
+		auxPclk = rcc_GetPclk2();
+	}
+	else{
+		auxPpre = (RCC->CFGR & RCC_CFGR_PPRE1) >> RCC_CFGR_PPRE1_Pos;
+		auxPclk = rcc_GetPclk1();
+	}
+
+	if(auxPpre >= 4){
+		return 2 * auxPclk;
+	}
+
+	return auxPclk;
+}
+
+/*
+ * f(PLL) = f(entrada) / PLLM * PLLN / PLLP, con PLLP = 2, 4, 6 u 8
+ */
+static uint32_t rcc_get_pll_clock(void){
+
+	uint32_t pllInput = RCC_HSI_VALUE;
+	uint32_t pllM = (RCC->PLLCFGR & RCC_PLLCFGR_PLLM) >> RCC_PLLCFGR_PLLM_Pos;
+	uint32_t pllN = (RCC->PLLCFGR & RCC_PLLCFGR_PLLN) >> RCC_PLLCFGR_PLLN_Pos;
+	uint32_t pllP = ((((RCC->PLLCFGR & RCC_PLLCFGR_PLLP) >> RCC_PLLCFGR_PLLP_Pos) + 1) * 2);
+
+	if(RCC->PLLCFGR & RCC_PLLCFGR_PLLSRC){
+		pllInput = RCC_HSE_VALUE;
+	}
+
+	if(pllM == 0){
+		return 0;
+	}
+
+	/* Se divide primero para no desbordar los 32 bits (VCO hasta 432 MHz) */
+	return ((pllInput / pllM) * pllN) / pllP;
+}
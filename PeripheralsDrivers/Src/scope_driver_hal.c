@@ -0,0 +1,249 @@
+/*
+ * scope_driver_hal.c
+ *
+ *  Created on: 19/10/2026
+ *      Author: laurasofia
+ */
+
+#include "stm32f4xx.h"
+#include "stm32_assert.h"
+
+#include "scope_driver_hal.h"
+#include "rcc_driver_hal.h"
+
+/* === Headers for private functions === */
+static void scope_block_ready(void *pContext, ADC_Stream_t *pStream, uint16_t *pBlock);
+static void scope_tx_complete(void *pContext, uint8_t status);
+static void scope_end_frame(Scope_Handler_t *pScopeHandler, uint8_t sent);
+static uint16_t scope_pack_block(Scope_Handler_t *pScopeHandler, uint16_t *pBlock, uint16_t *pChecksum);
+static void scope_build_header(Scope_Handler_t *pScopeHandler, uint32_t sequence, uint16_t checksum);
+static void scope_put_halfword(uint8_t *pData, uint16_t data);
+static void scope_put_word(uint8_t *pData, uint32_t data);
+
+/*
+ * Inicia el osciloscopio sobre el canal (adc_ConfigSingleChannel) o la secuencia
+ * (adc_ConfigMultiChannel) ya configurada, con alineación a la derecha.
+ * Toma el trigger del ADC, el callback del streaming y el callback de transmisión
+ * del USART, y enciende el timer. Se detiene con scope_Stop().
+ */
+uint8_t scope_Start(Scope_Handler_t *pScopeHandler){
+
+	uint8_t auxResolution = 0;
+
+	pScopeHandler->channels = ((ADC1->SQR1 & ADC_SQR1_L) >> ADC_SQR1_L_Pos) + 1;
+
+	/* 1. El bloque se empaqueta en su lugar: 12 bits necesitan pares de muestras */
+	if((pScopeHandler->config.pBuffer == 0) || (pScopeHandler->config.blockLength == 0) ||
+	   (pScopeHandler->config.pUsartHandler == 0) || (pScopeHandler->config.pTimerHandler == 0)){
+		return SCOPE_ERROR_CONFIG;
+	}
+	if((pScopeHandler->config.format == SCOPE_FORMAT_12BIT) && (pScopeHandler->config.blockLength & 1)){
+		return SCOPE_ERROR_CONFIG;
+	}
+	if((pScopeHandler->config.blockLength % pScopeHandler->channels) != 0){
+		return SCOPE_ERROR_CONFIG;
+	}
+
+	/* 2. Cada update del timer inicia una conversión (o una secuencia) */
+	if(adc_ConfigTimerTrigger(pScopeHandler->config.pTimerHandler) != ADC_TRIGGER_OK){
+		return SCOPE_ERROR_TRIGGER;
+	}
+
+	/* RES = 0b00 ... 0b11 corresponde a 12, 10, 8 y 6 bits */
+	auxResolution = 12 - 2 * ((ADC1->CR1 & ADC_CR1_RES) >> ADC_CR1_RES_Pos);
+
+	pScopeHandler->sampleShift     = 12 - auxResolution;
+	pScopeHandler->timerClock      = rcc_GetTimerClock(RCC_BUS_APB1);
+	pScopeHandler->cyclesPerSample = (pScopeHandler->config.pTimerHandler->pTIMx->PSC + 1) *
+	                                 (pScopeHandler->config.pTimerHandler->pTIMx->ARR + 1);
+
+	pScopeHandler->pPayload        = 0;
+	pScopeHandler->payloadBytes    = 0;
+	pScopeHandler->frameInProgress = 0;
+	pScopeHandler->framesSent      = 0;
+	pScopeHandler->droppedBlocks   = 0;
+	pScopeHandler->state           = SCOPE_STATE_RUNNING;
+
+	/* 3. Los bloques llegan al ISR del DMA del ADC y las tramas se encadenan en el del USART */
+	usart_RegisterTxCallback(pScopeHandler->config.pUsartHandler, scope_tx_complete, pScopeHandler);
+	adc_RegisterStreamCallback(scope_block_ready, pScopeHandler);
+
+	pScopeHandler->stream.pBuffer     = pScopeHandler->config.pBuffer;
+	pScopeHandler->stream.blockLength = pScopeHandler->config.blockLength;
+	adc_StartStream(&pScopeHandler->stream);
+
+	/* 4. Con el timer encendido comienzan las conversiones */
+	timer_SetState(pScopeHandler->config.pTimerHandler, TIMER_ON);
+
+	return SCOPE_OK;
+}
+
+/*
+ * Detiene el timer y el streaming. La trama que esté saliendo termina de enviarse,
+ * y al final se libera el callback de transmisión del USART.
+ */
+void scope_Stop(Scope_Handler_t *pScopeHandler){
+
+	timer_SetState(pScopeHandler->config.pTimerHandler, TIMER_OFF);
+
+	adc_StopStream();
+	adc_RegisterStreamCallback(0, 0);
+
+	pScopeHandler->state = SCOPE_STATE_IDLE;
+
+	/* Si hay una trama saliendo, el ISR libera el callback al terminarla */
+	if(!pScopeHandler->frameInProgress){
+		usart_RegisterTxCallback(pScopeHandler->config.pUsartHandler, 0, 0);
+	}
+}
+
+/*
+ * Bloque nuevo (ISR del DMA del ADC). Si el USART todavía envía la trama anterior
+ * el bloque se descarta; si no, se empaqueta y se envía el encabezado.
+ */
+static void scope_block_ready(void *pContext, ADC_Stream_t *pStream, uint16_t *pBlock){
+
+	Scope_Handler_t *pScopeHandler = (Scope_Handler_t *)pContext;
+	uint16_t        auxChecksum    = 0;
+
+	if(pScopeHandler->frameInProgress){
+		pScopeHandler->droppedBlocks++;
+		return;
+	}
+
+	pScopeHandler->frameInProgress = 1;
+	pScopeHandler->payloadBytes    = scope_pack_block(pScopeHandler, pBlock, &auxChecksum);
+	pScopeHandler->pPayload        = (uint8_t *)pBlock;
+
+	/* blocksCompleted ya cuenta este bloque: el primero es el número 0 */
+	scope_build_header(pScopeHandler, pStream->blocksCompleted - 1, auxChecksum);
+
+	/* Si el DMA del USART lo tiene otro usuario, el bloque se pierde pero el osciloscopio sigue */
+	if(usart_WriteDma(pScopeHandler->config.pUsartHandler, pScopeHandler->header, SCOPE_HEADER_SIZE) != USART_DMA_OK){
+		pScopeHandler->pPayload = 0;
+		scope_end_frame(pScopeHandler, 0);
+	}
+}
+
+/*
+ * Fin de una transmisión (ISR del DMA del USART): después del encabezado sale el
+ * bloque, y después del bloque este se devuelve al streaming. Si el DMA falló, la
+ * trama se cierra como descartada sin enviar lo que falta.
+ */
+static void scope_tx_complete(void *pContext, uint8_t status){
+
+	Scope_Handler_t *pScopeHandler = (Scope_Handler_t *)pContext;
+	uint8_t         *auxPayload    = pScopeHandler->pPayload;
+
+	if(status != USART_DMA_OK){
+		pScopeHandler->pPayload = 0;
+		scope_end_frame(pScopeHandler, 0);
+		return;
+	}
+
+	if(auxPayload != 0){
+		pScopeHandler->pPayload = 0;
+		if(usart_WriteDma(pScopeHandler->config.pUsartHandler, auxPayload, pScopeHandler->payloadBytes) != USART_DMA_OK){
+			scope_end_frame(pScopeHandler, 0);
+		}
+		return;
+	}
+
+	scope_end_frame(pScopeHandler, 1);
+}
+
+/*
+ * Cierra la trama actual: el bloque vuelve al streaming y se cuenta como enviado o como
+ * descartado (sent = 0, el USART no aceptó la transmisión o el DMA falló).
+ */
+static void scope_end_frame(Scope_Handler_t *pScopeHandler, uint8_t sent){
+
+	if(sent){
+		pScopeHandler->framesSent++;
+	}
+	else{
+		pScopeHandler->droppedBlocks++;
+	}
+
+	adc_StreamReleaseBlock(&pScopeHandler->stream);
+	pScopeHandler->frameInProgress = 0;
+
+	if(pScopeHandler->state == SCOPE_STATE_IDLE){
+		usart_RegisterTxCallback(pScopeHandler->config.pUsartHandler, 0, 0);
+	}
+}
+
+/*
+ * Empaqueta el bloque sobre sí mismo y retorna cuántos bytes ocupa. Cada byte escrito
+ * está en una posición igual o anterior a la de las muestras que lo forman, por lo que
+ * nunca se pisa una muestra que no se ha leído.
+ */
+static uint16_t scope_pack_block(Scope_Handler_t *pScopeHandler, uint16_t *pBlock, uint16_t *pChecksum){
+
+	uint8_t  *pOutput   = (uint8_t *)pBlock;
+	uint16_t auxIndex   = 0;
+	uint16_t auxSampleA = 0;
+	uint16_t auxSampleB = 0;
+	uint16_t auxBytes   = 0;
+	uint16_t auxSum     = 0;
+
+	if(pScopeHandler->config.format == SCOPE_FORMAT_8BIT){
+
+		for(auxIndex = 0; auxIndex < pScopeHandler->config.blockLength; auxIndex++){
+			auxSampleA = (pBlock[auxIndex] << pScopeHandler->sampleShift) >> 4;
+
+			pOutput[auxIndex] = (uint8_t)auxSampleA;
+			auxSum           += (uint8_t)auxSampleA;
+		}
+
+		auxBytes = pScopeHandler->config.blockLength;
+	}
+	else{
+
+		for(auxIndex = 0; auxIndex < pScopeHandler->config.blockLength; auxIndex += 2){
+			auxSampleA = (pBlock[auxIndex]     << pScopeHandler->sampleShift) & 0x0FFF;
+			auxSampleB = (pBlock[auxIndex + 1] << pScopeHandler->sampleShift) & 0x0FFF;
+
+			pOutput[auxBytes]     = (uint8_t)auxSampleA;
+			pOutput[auxBytes + 1] = (uint8_t)((auxSampleA >> 8) | (auxSampleB << 4));
+			pOutput[auxBytes + 2] = (uint8_t)(auxSampleB >> 4);
+
+			auxSum   += pOutput[auxBytes] + pOutput[auxBytes + 1] + pOutput[auxBytes + 2];
+			auxBytes += 3;
+		}
+	}
+
+	*pChecksum = auxSum;
+
+	return auxBytes;
+}
+
+/* Llena el encabezado con el formato descrito en el .h */
+static void scope_build_header(Scope_Handler_t *pScopeHandler, uint32_t sequence, uint16_t checksum){
+
+	uint8_t *pHeader = pScopeHandler->header;
+
+	pHeader[0] = SCOPE_SYNC_0;
+	pHeader[1] = SCOPE_SYNC_1;
+	pHeader[2] = (pScopeHandler->config.format == SCOPE_FORMAT_8BIT) ? 8 : 12;
+	pHeader[3] = pScopeHandler->channels;
+	scope_put_word(&pHeader[4], sequence);
+	scope_put_word(&pHeader[8], pScopeHandler->droppedBlocks);
+	scope_put_word(&pHeader[12], pScopeHandler->timerClock);
+	scope_put_word(&pHeader[16], pScopeHandler->cyclesPerSample);
+	scope_put_halfword(&pHeader[20], pScopeHandler->config.blockLength);
+	scope_put_halfword(&pHeader[22], pScopeHandler->payloadBytes);
+	scope_put_halfword(&pHeader[24], checksum);
+}
+
+/**/
+static void scope_put_halfword(uint8_t *pData, uint16_t data){
+	pData[0] = data & 0xFF;
+	pData[1] = (data >> 8) & 0xFF;
+}
+
+/**/
+static void scope_put_word(uint8_t *pData, uint32_t data){
+	scope_put_halfword(&pData[0], data & 0xFFFF);
+	scope_put_halfword(&pData[2], (data >> 16) & 0xFFFF);
+}
@@ -13,12 +13,41 @@
 /* Variable que guarda la referencia del periférico que se está utilizando */
 TIM_TypeDef *ptrTimerUsed;
 
+/* Timers que pueden lanzar interrupción por update, en el orden de las tablas de callbacks */
+#define TIMER_CALLBACK_COUNT    7
+
+enum
+{
+	TIMER_INDEX_2 = 0,
+	TIMER_INDEX_3,
+	TIMER_INDEX_4,
+	TIMER_INDEX_5,
+	TIMER_INDEX_9,
+	TIMER_INDEX_10,
+	TIMER_INDEX_11
+};
+
+static TIM_TypeDef * const timerInstances[TIMER_CALLBACK_COUNT] = {
+		TIM2, TIM3, TIM4, TIM5, TIM9, TIM10, TIM11
+};
+
+/* Capa de compatibilidad: callbacks "weak" que se llaman si no hay uno registrado */
+static void (* const timerLegacyCallback[TIMER_CALLBACK_COUNT])(void) = {
+		Timer2_Callback, Timer3_Callback, Timer4_Callback, Timer5_Callback,
+		Timer9_Callback, Timer10_Callback, Timer11_Callback
+};
+
+/* Callbacks registrados en tiempo de ejecución, con su contexto */
+static Timer_Callback_t timerCallback[TIMER_CALLBACK_COUNT] = {0};
+static void             *timerCallbackContext[TIMER_CALLBACK_COUNT] = {0};
+
 /* ==== Headers for private functions ==== */
 static void timer_enable_clock_peripheral(Timer_Handler_t *pTimerHandler);
 static void timer_set_prescaler(Timer_Handler_t *pTimerHandler);
 static void timer_set_period(Timer_Handler_t *pTimerHandler);
 static void timer_set_mode(Timer_Handler_t *pTimerHandler);
 static void timer_config_interrupt(Timer_Handler_t *pTimerHandler);
+static void timer_dispatch(uint8_t timerIndex);
 
 /* Función en la que cargamos la configuración del Timer
  * Recordar que siempre se debe comenzar con activar la señal de reloj
@@ -249,6 +278,41 @@ void timer_SetState(Timer_Handler_t *pTimerHandler, uint8_t newState){
 	}
 }
 
+/*
+ * Registra la función que se llama con cada update del timer, junto con un puntero
+ * de contexto (por ejemplo el handler de la aplicación que usa el timer).
+ * Con callback = 0 se vuelve a llamar la función TimerX_Callback().
+ */
+void timer_RegisterCallback(Timer_Handler_t *pTimerHandler, Timer_Callback_t callback, void *pContext){
+
+	uint8_t timerIndex = 0;
+
+	for(timerIndex = 0; timerIndex < TIMER_CALLBACK_COUNT; timerIndex++){
+
+		if(timerInstances[timerIndex] == pTimerHandler->pTIMx){
+
+			/* El ISR no debe ver la función nueva con el contexto viejo */
+			__disable_irq();
+			timerCallback[timerIndex]        = callback;
+			timerCallbackContext[timerIndex] = pContext;
+			__enable_irq();
+
+			break;
+		}
+	}
+}
+
+/* Llama el callback registrado, o el callback "weak" si no hay ninguno */
+static void timer_dispatch(uint8_t timerIndex){
+
+	if(timerCallback[timerIndex] != 0){
+		timerCallback[timerIndex](timerCallbackContext[timerIndex]);
+	}
+	else{
+		timerLegacyCallback[timerIndex]();
+	}
+}
+
 /**/
 __attribute__((weak)) void Timer2_Callback(void){
 	__NOP();
@@ -288,7 +352,7 @@ void TIM2_IRQHandler(void){
 	TIM2->SR &= ~TIM_SR_UIF;
 
 	/* Llamamos a la función que se debe encargar de hacer algo con esta interrupción */
-	Timer2_Callback();
+	timer_dispatch(TIMER_INDEX_2);
 
 }
 
@@ -297,7 +361,7 @@ void TIM3_IRQHandler(void){
 	TIM3->SR &= ~TIM_SR_UIF;
 
 	/* Llamamos a la función que se debe encargar de hacer algo con esta interrupción */
-	Timer3_Callback();
+	timer_dispatch(TIMER_INDEX_3);
 
 }
 
@@ -306,7 +370,7 @@ void TIM4_IRQHandler(void){
 	TIM4->SR &= ~TIM_SR_UIF;
 
 	/* Llamamos a la función que se debe encargar de hacer algo con esta interrupción */
-	Timer4_Callback();
+	timer_dispatch(TIMER_INDEX_4);
 
 }
 
@@ -315,7 +379,7 @@ void TIM5_IRQHandler(void){
 	TIM5->SR &= ~TIM_SR_UIF;
 
 	/* Llamamos a la función que se debe encargar de hacer algo con esta interrupción */
-	Timer5_Callback();
+	timer_dispatch(TIMER_INDEX_5);
 
 }
 
@@ -324,7 +388,7 @@ void TIM9_IRQHandler(void){
 	TIM9->SR &= ~TIM_SR_UIF;
 
 	/* Llamamos a la función que se debe encargar de hacer algo con esta interrupción */
-	Timer9_Callback();
+	timer_dispatch(TIMER_INDEX_9);
 
 }
 
@@ -333,7 +397,7 @@ void TIM10_IRQHandler(void){
 	TIM10->SR &= ~TIM_SR_UIF;
 
 	/* Llamamos a la función que se debe encargar de hacer algo con esta interrupción */
-	Timer10_Callback();
+	timer_dispatch(TIMER_INDEX_10);
 
 }
 
@@ -342,7 +406,7 @@ void TIM11_IRQHandler(void){
 	TIM11->SR &= ~TIM_SR_UIF;
 
 	/* Llamamos a la función que se debe encargar de hacer algo con esta interrupción */
-	Timer11_Callback();
+	timer_dispatch(TIMER_INDEX_11);
 
 }
 
@@ -7,10 +7,50 @@
 
 #include "stm32f4xx.h"
 #include "usart_driver_hal.h"
+#include "deadline_driver_hal.h"
+#include "dma_driver_hal.h"
+#include "rcc_driver_hal.h"
 
 
 uint8_t auxRxData = 0;
 
+/* USART que pueden lanzar interrupción por RX, en el orden de las tablas de callbacks */
+#define USART_CALLBACK_COUNT    3
+
+enum
+{
+	USART_INDEX_1 = 0,
+	USART_INDEX_2,
+	USART_INDEX_6
+};
+
+static USART_TypeDef * const usartInstances[USART_CALLBACK_COUNT] = {
+		USART1, USART2, USART6
+};
+
+/* Capa de compatibilidad: callbacks "weak" que se llaman si no hay uno registrado */
+static void (* const usartLegacyRxCallback[USART_CALLBACK_COUNT])(void) = {
+		usart1_RxCallback, usart2_RxCallback, usart6_RxCallback
+};
+
+/* Callbacks registrados en tiempo de ejecución, con su contexto */
+static USART_Callback_t usartRxCallback[USART_CALLBACK_COUNT] = {0};
+static void             *usartRxContext[USART_CALLBACK_COUNT] = {0};
+
+/* Transmisión por DMA: stream y canal de USARTx_TX, en el mismo orden de usartInstances */
+static DMA_Stream_TypeDef * const usartTxDmaStream[USART_CALLBACK_COUNT] = {
+		DMA2_Stream7, DMA1_Stream6, DMA2_Stream6
+};
+
+static const uint8_t usartTxDmaChannel[USART_CALLBACK_COUNT] = {
+		DMA_CHANNEL_4, DMA_CHANNEL_4, DMA_CHANNEL_5
+};
+
+static DMA_Handler_t      handlerUsartTxDma[USART_CALLBACK_COUNT] = {0};
+static volatile uint8_t   usartTxDmaBusy[USART_CALLBACK_COUNT]    = {0};
+static USART_TxCallback_t usartTxCallback[USART_CALLBACK_COUNT]   = {0};
+static void               *usartTxContext[USART_CALLBACK_COUNT]   = {0};
+
 /* === Headers for private functions === */
 static void usart_enable_clock_peripheral(USART_Handler_t *ptrUsartHandler);
 static void usart_config_parity(USART_Handler_t *ptrUsartHandler);
@@ -20,6 +60,11 @@ static void usart_config_baudrate(USART_Handler_t *ptrUsartHandler);
 static void usart_config_mode(USART_Handler_t *ptrUsartHandler);
 static void usart_config_interrupt(USART_Handler_t *ptrUsartHandler);
 static void usart_enable_peripheral(USART_Handler_t *ptrUsartHandler);
+static void usart_dispatch_rx(uint8_t usartIndex);
+static uint8_t usart_get_index(USART_TypeDef *pUSARTx);
+static uint32_t usart_get_clock(USART_TypeDef *pUSARTx);
+static void usart_config_tx_dma(uint8_t usartIndex);
+static void usart_tx_dma_irq(uint8_t usartIndex);
 
 
 
@@ -233,6 +278,14 @@ static void usart_config_baudrate(USART_Handler_t *ptrUsartHandler){
 			ptrUsartHandler->ptrUSARTx->BRR = 0x0045;
 			break;
 		}
+		case USART_BAUDRATE_921600:
+		{
+			// Con 16 MHz el valor es 1.085 -> no hay una combinación exacta (0x0011 da 941 kbps, 2.1 %)
+			// Se calcula con el reloj real del bus: BRR = fPCLK / baudrate, redondeado
+			// (con OVER8 = 0 la mantisa y la fracción forman justo ese número)
+			ptrUsartHandler->ptrUSARTx->BRR = (usart_get_clock(ptrUsartHandler->ptrUSARTx) + 921600 / 2) / 921600;
+			break;
+		}
 
 		default:
 			// Configurando el Baudrate generator para una velocidad de 115200bps
@@ -331,10 +384,17 @@ static void usart_enable_peripheral(USART_Handler_t *ptrUsartHandler){
 
 /*
  * función para escribir un solo char
+ * Retorna el dato enviado, o USART_WRITE_TIMEOUT si el TDR no se liberó a tiempo
+ * (por ejemplo si el USART no está habilitado o le falta el reloj).
  */
 int usart_WriteChar(USART_Handler_t *ptrUsartHandler, int dataToSend ){
+
+	Deadline_t deadline = deadline_Start(USART_TIMEOUT_US);
+
 	while( !(ptrUsartHandler->ptrUSARTx->SR & USART_SR_TXE)){
-		__NOP();
+		if(deadline_Expired(&deadline)){
+			return USART_WRITE_TIMEOUT;
+		}
 	}
 
 	// Cuando el TDR está listo para transmisión de datos se procede a almacenar la indormación del DR
@@ -344,27 +404,204 @@ int usart_WriteChar(USART_Handler_t *ptrUsartHandler, int dataToSend ){
 }
 
 /*
- *
+ * Envía un string terminado en '\0'.
+ * Retorna 0, o USART_WRITE_TIMEOUT si algún caracter no se pudo enviar (el resto se descarta).
  */
-void usart_writeMsg(USART_Handler_t *ptrUsartHandler, char *msgToSend ){
+int usart_writeMsg(USART_Handler_t *ptrUsartHandler, char *msgToSend ){
 
 	//Evaluamos que el caracter a enviar sea diferente al caracter NULO
 	//Si lo anterior se cumple se almacena en el Data Register
 	while(*msgToSend != '\0'){
 
 		//Almacenamos la información en el DR
-		usart_WriteChar(ptrUsartHandler, *msgToSend); //CONFIRMAR
+		if(usart_WriteChar(ptrUsartHandler, *msgToSend) == USART_WRITE_TIMEOUT){
+			return USART_WRITE_TIMEOUT;
+		}
 
 		//Modificamos valor puntero para que pase a evaluar la totalidad del string
 		msgToSend++;
 	}
 
+	return 0;
 }
 
 uint8_t usart_getRxData(void){
 	return auxRxData;
 }
 
+/*
+ * Registra la función que se llama con cada dato recibido por el USART del handler,
+ * junto con un puntero de contexto. El dato llega como parámetro, por lo que no se
+ * comparte auxRxData entre varios USART.
+ * Con callback = 0 se vuelve a llamar la función usartX_RxCallback().
+ */
+void usart_RegisterRxCallback(USART_Handler_t *ptrUsartHandler, USART_Callback_t callback, void *pContext){
+
+	uint8_t usartIndex = usart_get_index(ptrUsartHandler->ptrUSARTx);
+
+	if(usartIndex >= USART_CALLBACK_COUNT){
+		return;
+	}
+
+	/* El ISR no debe ver la función nueva con el contexto viejo */
+	__disable_irq();
+	usartRxCallback[usartIndex] = callback;
+	usartRxContext[usartIndex]  = pContext;
+	__enable_irq();
+}
+
+/*
+ * Envía length bytes de pData por DMA y retorna de inmediato. pData debe existir (y no
+ * modificarse) hasta que termine la transmisión, que se avisa con el callback registrado
+ * con usart_RegisterTxCallback() o con usart_TxCompleteCallback().
+ * Retorna USART_DMA_BUSY si todavía se está enviando el arreglo anterior.
+ */
+uint8_t usart_WriteDma(USART_Handler_t *ptrUsartHandler, const uint8_t *pData, uint16_t length){
+
+	uint8_t usartIndex = usart_get_index(ptrUsartHandler->ptrUSARTx);
+
+	if(usartIndex >= USART_CALLBACK_COUNT){
+		return USART_DMA_UNSUPPORTED;
+	}
+
+	if(usartTxDmaBusy[usartIndex]){
+		return USART_DMA_BUSY;
+	}
+
+	if(length == 0){
+		return USART_DMA_OK;
+	}
+
+	/* El stream se configura la primera vez que se usa */
+	if(handlerUsartTxDma[usartIndex].pStream == 0){
+		usart_config_tx_dma(usartIndex);
+	}
+
+	usartTxDmaBusy[usartIndex] = 1;
+
+	/* El USART pide un dato al DMA cada vez que se libera el TDR (TXE) */
+	ptrUsartHandler->ptrUSARTx->CR3 |= USART_CR3_DMAT;
+
+	dma_StartTransfer(&handlerUsartTxDma[usartIndex], (uint32_t)&ptrUsartHandler->ptrUSARTx->DR,
+			(uint32_t)pData, 0, length);
+
+	return USART_DMA_OK;
+}
+
+/* Retorna 1 mientras haya una transmisión por DMA en curso */
+uint8_t usart_TxDmaBusy(USART_Handler_t *ptrUsartHandler){
+
+	uint8_t usartIndex = usart_get_index(ptrUsartHandler->ptrUSARTx);
+
+	if(usartIndex >= USART_CALLBACK_COUNT){
+		return 0;
+	}
+
+	return usartTxDmaBusy[usartIndex];
+}
+
+/*
+ * Registra la función que se llama al terminar cada transmisión por DMA. Desde ella se
+ * puede iniciar la siguiente con usart_WriteDma() (por ejemplo, para encadenar arreglos).
+ * Con callback = 0 se vuelve a llamar la función usart_TxCompleteCallback().
+ */
+void usart_RegisterTxCallback(USART_Handler_t *ptrUsartHandler, USART_TxCallback_t callback, void *pContext){
+
+	uint8_t usartIndex = usart_get_index(ptrUsartHandler->ptrUSARTx);
+
+	if(usartIndex >= USART_CALLBACK_COUNT){
+		return;
+	}
+
+	__disable_irq();
+	usartTxCallback[usartIndex] = callback;
+	usartTxContext[usartIndex]  = pContext;
+	__enable_irq();
+}
+
+/* Posición del USART en las tablas del driver, o USART_CALLBACK_COUNT si no está */
+static uint8_t usart_get_index(USART_TypeDef *pUSARTx){
+
+	uint8_t usartIndex = 0;
+
+	for(usartIndex = 0; usartIndex < USART_CALLBACK_COUNT; usartIndex++){
+		if(usartInstances[usartIndex] == pUSARTx){
+			break;
+		}
+	}
+
+	return usartIndex;
+}
+
+/* El USART2 está en el APB1; el USART1 y el USART6 en el APB2 */
+static uint32_t usart_get_clock(USART_TypeDef *pUSARTx){
+
+	if(pUSARTx == USART2){
+		return rcc_GetPclk1();
+	}
+
+	return rcc_GetPclk2();
+}
+
+/* Memoria (8 bit, con incremento) -> DR (8 bit), modo normal, con interrupción de fin */
+static void usart_config_tx_dma(uint8_t usartIndex){
+
+	handlerUsartTxDma[usartIndex].pStream                   = usartTxDmaStream[usartIndex];
+	handlerUsartTxDma[usartIndex].config.channel            = usartTxDmaChannel[usartIndex];
+	handlerUsartTxDma[usartIndex].config.direction          = DMA_DIR_MEM_TO_PERIPH;
+	handlerUsartTxDma[usartIndex].config.periphDataSize     = DMA_DATASIZE_8BIT;
+	handlerUsartTxDma[usartIndex].config.memDataSize        = DMA_DATASIZE_8BIT;
+	handlerUsartTxDma[usartIndex].config.periphIncrement    = DMA_INCREMENT_DISABLE;
+	handlerUsartTxDma[usartIndex].config.memIncrement       = DMA_INCREMENT_ENABLE;
+	handlerUsartTxDma[usartIndex].config.mode               = DMA_MODE_NORMAL;
+	handlerUsartTxDma[usartIndex].config.priority           = DMA_PRIORITY_MEDIUM;
+	handlerUsartTxDma[usartIndex].config.interruptHalf      = DMA_INT_DISABLE;
+	handlerUsartTxDma[usartIndex].config.interruptComplete  = DMA_INT_ENABLE;
+
+	dma_Config(&handlerUsartTxDma[usartIndex]);
+}
+
+/*
+ * Fin (o error) de la transmisión por DMA. El DMA termina cuando el último byte pasa
+ * al DR, un caracter antes de que salga por el pin; esto no afecta a la siguiente
+ * transmisión, que espera el TXE como cualquier otro dato.
+ */
+static void usart_tx_dma_irq(uint8_t usartIndex){
+
+	uint8_t auxFlags  = dma_ReadFlags(usartTxDmaStream[usartIndex]);
+	uint8_t auxStatus = USART_DMA_OK;
+
+	dma_ClearFlags(usartTxDmaStream[usartIndex], auxFlags);
+
+	if(auxFlags & (DMA_FLAG_TCIF | DMA_FLAG_TEIF)){
+
+		/* Con TEIF el stream se deshabilita solo y no todo el arreglo salió */
+		if(auxFlags & DMA_FLAG_TEIF){
+			auxStatus = USART_DMA_ERROR;
+		}
+
+		usartTxDmaBusy[usartIndex] = 0;
+
+		if(usartTxCallback[usartIndex] != 0){
+			usartTxCallback[usartIndex](usartTxContext[usartIndex], auxStatus);
+		}
+		else{
+			usart_TxCompleteCallback(auxStatus);
+		}
+	}
+}
+
+/* Llama el callback registrado, o el callback "weak" si no hay ninguno */
+static void usart_dispatch_rx(uint8_t usartIndex){
+
+	if(usartRxCallback[usartIndex] != 0){
+		usartRxCallback[usartIndex](usartRxContext[usartIndex], auxRxData);
+	}
+	else{
+		usartLegacyRxCallback[usartIndex]();
+	}
+}
+
 /* Handler de la interrupción del USART
  * Acá deben estar todas las interrupciones asociadas: TX, RX, PE...
  */
@@ -376,7 +613,7 @@ void USART2_IRQHandler(void){
     	auxRxData = USART2->DR;
 
     	//Llamamos a la función callback
-    	usart2_RxCallback();
+    	usart_dispatch_rx(USART_INDEX_2);
     }
 }
 
@@ -391,7 +628,7 @@ void USART6_IRQHandler(void){
 		auxRxData = USART6->DR;
 
 		//Llamamos a la función callback
-	    usart6_RxCallback();
+	    usart_dispatch_rx(USART_INDEX_6);
 	}
 }
 
@@ -406,11 +643,25 @@ void USART1_IRQHandler(void){
 		auxRxData = USART1->DR;
 
 		//Llamamos a la función callback
-	    usart1_RxCallback();
+	    usart_dispatch_rx(USART_INDEX_1);
 	}
 }
 
 
+/* ISR de los streams de transmisión por DMA */
+void DMA2_Stream7_IRQHandler(void){
+	usart_tx_dma_irq(USART_INDEX_1);
+}
+
+void DMA1_Stream6_IRQHandler(void){
+	usart_tx_dma_irq(USART_INDEX_2);
+}
+
+void DMA2_Stream6_IRQHandler(void){
+	usart_tx_dma_irq(USART_INDEX_6);
+}
+
+
 __attribute__((weak)) void usart1_RxCallback(void){
 	  /* NOTE : This function should not be modified, when the callback is needed,
 	            the BasicTimer_Callback could be implemented in the main file
@@ -431,3 +682,8 @@ __attribute__((weak)) void usart6_RxCallback(void){
 	   */
 	__NOP();
 }
+
+__attribute__((weak)) void usart_TxCompleteCallback(uint8_t status){
+	(void)status;
+	__NOP();
+}
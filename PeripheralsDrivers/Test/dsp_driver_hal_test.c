@@ -0,0 +1,260 @@
+/*
+ * dsp_driver_hal_test.c
+ *
+ *  Created on: 19/10/2026
+ *      Author: laurasofia
+ */
+
+/*
+ * Pruebas en el PC de los filtros de dsp_driver_hal. El módulo se incluye completo
+ * (también sus funciones privadas) y se compila sin CMSIS:
+ *
+ *   gcc -std=gnu11 -Wall -Wextra -I../Inc -o dsp_test dsp_driver_hal_test.c && ./dsp_test
+ *   gcc -std=gnu11 -Wall -Wextra -I../Inc -DDSP_USE_SIMD=0 -o dsp_test dsp_driver_hal_test.c && ./dsp_test
+ *
+ * Con DSP_USE_SIMD = 1 (por defecto) las instrucciones SMLALD, PKHBT y SSAT se emulan
+ * según su definición en el manual de arquitectura ARMv7-M, y el biquad en C se compara
+ * con la versión SIMD. Con DSP_USE_SIMD = 0 se prueba la versión en C de todo el módulo.
+ * Retorna 0 si todas las pruebas pasan.
+ */
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+#define DSP_HOST_TEST   1
+
+#ifndef DSP_USE_SIMD
+#define DSP_USE_SIMD    1
+#endif
+
+#if DSP_USE_SIMD
+/* Dos productos con signo de 16 bits (mitades baja y alta) acumulados en 64 bits */
+static inline uint64_t __SMLALD(uint32_t op1, uint32_t op2, uint64_t acc){
+	return (uint64_t)((int64_t)acc + (int32_t)(int16_t)op1 * (int16_t)op2 +
+			(int32_t)(int16_t)(op1 >> 16) * (int16_t)(op2 >> 16));
+}
+
+/* Mitad baja de op1 y mitad alta de (op2 << shift) */
+#define __PKHBT(op1, op2, shift)  ((((uint32_t)(op1)) & 0x0000FFFFUL) | ((((uint32_t)(op2)) << (shift)) & 0xFFFF0000UL))
+
+/* Saturación con signo a "bits" bits */
+static inline int32_t dsp_test_ssat(int32_t value, uint32_t bits){
+
+	int32_t auxMax = (1 << (bits - 1)) - 1;
+	int32_t auxMin = -(1 << (bits - 1));
+
+	if(value > auxMax){
+		return auxMax;
+	}
+	if(value < auxMin){
+		return auxMin;
+	}
+	return value;
+}
+#define __SSAT(value, bits)  dsp_test_ssat((value), (bits))
+#endif
+
+#include "../Src/dsp_driver_hal.c"
+
+static uint32_t testFailures = 0;
+
+/* === Headers for private functions === */
+static void test_check(int condition, const char *pName, int32_t expected, int32_t obtained);
+static void test_moving_average_step(void);
+static void test_cic_dc_gain(void);
+static void test_median_duplicates(void);
+static void test_biquad_paths(void);
+
+int main(void){
+
+	srand(1234);
+
+	test_moving_average_step();
+	test_cic_dc_gain();
+	test_median_duplicates();
+	test_biquad_paths();
+
+	printf("DSP_USE_SIMD = %d: %s (%lu fallas)\n", DSP_USE_SIMD,
+			(testFailures == 0) ? "OK" : "FALLA", (unsigned long)testFailures);
+
+	return (testFailures == 0) ? 0 : 1;
+}
+
+/* Reporta solo las primeras fallas, para no llenar la consola */
+static void test_check(int condition, const char *pName, int32_t expected, int32_t obtained){
+
+	if(!condition){
+		if(testFailures < 20){
+			printf("FALLA %s: esperado %ld, obtenido %ld\n", pName, (long)expected, (long)obtained);
+		}
+		testFailures++;
+	}
+}
+
+/*
+ * Escalón de 1000 sobre un promedio de 8 muestras: la salida sube en rampa
+ * (1000 * k / 8) y desde la muestra 8 queda exactamente en 1000.
+ */
+static void test_moving_average_step(void){
+
+	DSP_MovingAverage_t filter = {0};
+	q15_t    history[8];
+	q15_t    output = 0;
+	int32_t  k      = 0;
+
+	dsp_MovingAverageInit(&filter, history, 3);
+
+	for(k = 1; k <= 32; k++){
+		output = dsp_MovingAverage(&filter, 1000);
+		test_check(output == (((k < 8) ? k : 8) * 1000) >> 3, "promedio escalon", (((k < 8) ? k : 8) * 1000) >> 3, output);
+	}
+
+	/* Escalón negativo: el desplazamiento aritmético redondea hacia -infinito */
+	dsp_MovingAverageInit(&filter, history, 3);
+	for(k = 1; k <= 16; k++){
+		output = dsp_MovingAverage(&filter, -1000);
+	}
+	test_check(output == -1000, "promedio escalon negativo", -1000, output);
+}
+
+/*
+ * Ganancia DC del CIC para cada orden y decimación permitidos (orden * log2R <= 16):
+ * una entrada constante entrega una salida cada R muestras y, pasado el transitorio
+ * de "orden" salidas, la salida es igual a la entrada.
+ */
+static void test_cic_dc_gain(void){
+
+	static const q15_t inputs[3] = { 1000, -1000, 2047 };
+	DSP_Cic_t filter  = {0};
+	q15_t     output  = 0;
+	uint8_t   order   = 0;
+	uint8_t   log2R   = 0;
+	uint8_t   input   = 0;
+	uint32_t  n       = 0;
+	uint32_t  outputs = 0;
+
+	for(order = 1; order <= DSP_CIC_MAX_ORDER; order++){
+		for(log2R = 1; (order * log2R) <= 16; log2R++){
+			for(input = 0; input < 3; input++){
+
+				dsp_CicInit(&filter, order, log2R);
+				outputs = 0;
+
+				for(n = 0; n < ((uint32_t)(order + 4) << log2R); n++){
+					if(dsp_Cic(&filter, inputs[input], &output)){
+						outputs++;
+						if(outputs > order){
+							test_check(output == inputs[input], "cic ganancia DC", inputs[input], output);
+						}
+					}
+				}
+
+				test_check(outputs == (uint32_t)(order + 4), "cic salidas por entrada", order + 4, outputs);
+			}
+		}
+	}
+}
+
+/*
+ * Mediana de 5 con valores de 0 a 3 (muchos repetidos), comparada con la mediana de
+ * la ventana calculada ordenando una copia.
+ */
+static void test_median_duplicates(void){
+
+	DSP_Median_t filter = {0};
+	q15_t    window[5] = { 2, 2, 2, 2, 2 };
+	q15_t    sorted[5];
+	q15_t    sample   = 0;
+	q15_t    output   = 0;
+	q15_t    swap     = 0;
+	uint32_t n        = 0;
+	uint8_t  i        = 0;
+	uint8_t  j        = 0;
+
+	dsp_MedianInit(&filter, 5, 2);
+
+	for(n = 0; n < 5000; n++){
+
+		sample        = (q15_t)(rand() % 4);
+		window[n % 5] = sample;
+		output        = dsp_Median(&filter, sample);
+
+		for(i = 0; i < 5; i++){
+			sorted[i] = window[i];
+		}
+		for(i = 1; i < 5; i++){
+			for(j = i; (j > 0) && (sorted[j - 1] > sorted[j]); j--){
+				swap          = sorted[j - 1];
+				sorted[j - 1] = sorted[j];
+				sorted[j]     = swap;
+			}
+		}
+
+		test_check(output == sorted[2], "mediana con repetidos", sorted[2], output);
+	}
+}
+
+/*
+ * Biquad:
+ * - Con SIMD, la suma de productos en C y con SMLALD debe ser idéntica para estados y
+ *   coeficientes aleatorios en todo el rango de 16 bits.
+ * - El filtro completo se compara con una implementación de referencia en 64 bits.
+ */
+static void test_biquad_paths(void){
+
+	DSP_Biquad_t filter = {0};
+	q15_t    x1 = 0, x2 = 0, y1 = 0, y2 = 0;
+	q15_t    sample = 0;
+	q15_t    output = 0;
+	int64_t  acc    = 0;
+	int32_t  ref    = 0;
+	uint32_t n      = 0;
+
+#if DSP_USE_SIMD
+	for(n = 0; n < 100000; n++){
+
+		filter.b0 = (q15_t)rand();
+		filter.b1 = (q15_t)rand();
+		filter.b2 = (q15_t)rand();
+		filter.a1 = (q15_t)rand();
+		filter.a2 = (q15_t)rand();
+		filter.x1 = (q15_t)rand();
+		filter.x2 = (q15_t)rand();
+		filter.y1 = (q15_t)rand();
+		filter.y2 = (q15_t)rand();
+		sample    = (q15_t)rand();
+
+		acc = dsp_biquad_mac_c(&filter, sample);
+		test_check(acc == dsp_biquad_mac_simd(&filter, sample), "biquad C vs SMLALD",
+				(int32_t)(acc >> 14), (int32_t)(dsp_biquad_mac_simd(&filter, sample) >> 14));
+	}
+#endif
+
+	/* Pasa bajas (b = 0.0675, 0.1349, 0.0675; a1 = 1.1430, a2 = -0.4128) con ruido */
+	dsp_BiquadInit(&filter, DSP_FLOAT_TO_Q14(0.0675f), DSP_FLOAT_TO_Q14(0.1349f), DSP_FLOAT_TO_Q14(0.0675f),
+			DSP_FLOAT_TO_Q14(1.1430f), DSP_FLOAT_TO_Q14(-0.4128f));
+
+	for(n = 0; n < 5000; n++){
+
+		sample = (q15_t)((rand() % 20001) - 10000);
+		output = dsp_Biquad(&filter, sample);
+
+		acc = (int64_t)filter.b0 * sample + (int64_t)filter.b1 * x1 + (int64_t)filter.b2 * x2 +
+		      (int64_t)filter.a1 * y1 + (int64_t)filter.a2 * y2;
+		ref = (int32_t)((acc + (1 << 13)) >> 14);
+		if(ref > INT16_MAX){
+			ref = INT16_MAX;
+		}
+		if(ref < INT16_MIN){
+			ref = INT16_MIN;
+		}
+
+		test_check(output == ref, "biquad contra referencia", ref, output);
+
+		x2 = x1;
+		x1 = sample;
+		y2 = y1;
+		y1 = (q15_t)ref;
+	}
+}
@@ -15,6 +15,7 @@
 #include "exti_driver_hal.h"
 #include "usart_driver_hal.h"
 #include "pwm_driver_hal.h"
+#include "i2c_driver_hal.h"
 
 //Definimos pines a utilizar para verificación
 GPIO_Handler_t verificationLed    = {0}; //PinA5 (Led para verificación de correcto funcionamiento)
@@ -225,6 +226,45 @@ uint16_t periodValue = 0;
 #define  MAX_FREQUENCY  3000 //Aprox...
 #define  MIN_FREQUENCY  300  //Aprox...
 
+/* La tarjeta funciona como sensor I2C (esclavo) para un controlador externo.
+ * Mapa de registros: cada registro es de 8 bits. Solo la frecuencia y la aceleración
+ * ocupan dos registros seguidos, como un valor de 16 bits en little endian (byte bajo primero):
+ * 0x00 WHO_AM_I     -> I2C_SENSOR_ID
+ * 0x01 COUNTER      -> Se incrementa con cada medición publicada (da la vuelta en 255)
+ * 0x02 RED_PCT      -> Aporte porcentual del color rojo (0 - 100)
+ * 0x03 GREEN_PCT    -> Aporte porcentual del color verde
+ * 0x04 BLUE_PCT     -> Aporte porcentual del color azul
+ * 0x05 NOTE_FREQ_L  -> Frecuencia de la nota reproducida en Hz (uint16, byte bajo)
+ * 0x06 NOTE_FREQ_H  -> (byte alto)
+ * 0x07 - 0x0C       -> Aceleración X, Y, Z (int16, pares L/H). Esta tarjeta no tiene acelerómetro: quedan en 0
+ * */
+#define  I2C_SENSOR_ADDRESS     0x42
+#define  I2C_SENSOR_ID          0xA5
+#define  I2C_SENSOR_REG_COUNT   13
+
+enum
+{
+	SENSOR_REG_WHO_AM_I = 0,
+	SENSOR_REG_COUNTER,
+	SENSOR_REG_RED_PCT,
+	SENSOR_REG_GREEN_PCT,
+	SENSOR_REG_BLUE_PCT,
+	SENSOR_REG_NOTE_FREQ_L,
+	SENSOR_REG_NOTE_FREQ_H,
+	SENSOR_REG_ACCEL_X_L
+};
+
+//Pines y handler del I2C en modo esclavo (PB8 -> SCL, PB9 -> SDA)
+GPIO_Handler_t  pinSlaveSCL       = {0};
+GPIO_Handler_t  pinSlaveSDA       = {0};
+I2C_Handler_t   i2cSlave          = {0};
+
+//Archivo de registros (doble buffer) que lee el controlador externo
+uint8_t sensorRegBuffer0[I2C_SENSOR_REG_COUNT] = {0};
+uint8_t sensorRegBuffer1[I2C_SENSOR_REG_COUNT] = {0};
+I2C_SlaveRegFile_t sensorRegFile  = {0};
+uint8_t sensorRegCounter          = 0;
+
 //Definición función para configuración inicial
 void initialConfig(void);
 
@@ -278,6 +318,10 @@ uint16_t noteLimitFrecSimple(uint16_t scaleValueNote);
 //Definición de función para escalamiento de resultados RGB a frecuencia
 void getFrequency(void);
 
+//Definición de funciones para exponer las mediciones como sensor I2C
+void configI2CSlave(void);
+void publishI2CSlave(void);
+
 /*  Main function  */
 int main(void)
 {
@@ -305,6 +349,9 @@ int main(void)
 		//Llamamos a función para calcular valor de frecuencia a calcular
 		getFrequency();
 
+		//Publicamos la medición en el archivo de registros del I2C esclavo
+		publishI2CSlave();
+
 		//Llamamos a la función encargada de representación en USART
 		msgUsart();
 
@@ -484,6 +531,72 @@ void initialConfig(){
 
 		gpio_Config(&pinPWMChannel);
 
+		//Configuramos el I2C en modo esclavo
+		configI2CSlave();
+
+}
+
+//Función para configurar el I2C1 como esclavo con el archivo de registros de las mediciones
+void configI2CSlave(void){
+
+	/*Configuración pin asociado a SCL*/
+	pinSlaveSCL.pGPIOx                          = GPIOB;
+	pinSlaveSCL.pinConfig.GPIO_PinNumber        = PIN_8;
+	pinSlaveSCL.pinConfig.GPIO_PinMode          = GPIO_MODE_ALTFN;
+	pinSlaveSCL.pinConfig.GPIO_PinOutputType    = GPIO_OTYPE_OPENDRAIN;
+	pinSlaveSCL.pinConfig.GPIO_PinPuPdControl   = GPIO_PUPDR_NOTHING;
+	pinSlaveSCL.pinConfig.GPIO_PinOutputSpeed   = GPIO_OSPEED_FAST;
+	pinSlaveSCL.pinConfig.GPIO_PinAltFunMode    = AF4;
+
+	gpio_Config(&pinSlaveSCL);
+
+	/*Configuración pin asociado a SDA*/
+	pinSlaveSDA.pGPIOx                          = GPIOB;
+	pinSlaveSDA.pinConfig.GPIO_PinNumber        = PIN_9;
+	pinSlaveSDA.pinConfig.GPIO_PinMode          = GPIO_MODE_ALTFN;
+	pinSlaveSDA.pinConfig.GPIO_PinOutputType    = GPIO_OTYPE_OPENDRAIN;
+	pinSlaveSDA.pinConfig.GPIO_PinPuPdControl   = GPIO_PUPDR_NOTHING;
+	pinSlaveSDA.pinConfig.GPIO_PinOutputSpeed   = GPIO_OSPEED_FAST;
+	pinSlaveSDA.pinConfig.GPIO_PinAltFunMode    = AF4;
+
+	gpio_Config(&pinSlaveSDA);
+
+	/*Los dos buffers comienzan con el identificador*/
+	sensorRegBuffer0[SENSOR_REG_WHO_AM_I] = I2C_SENSOR_ID;
+	sensorRegBuffer1[SENSOR_REG_WHO_AM_I] = I2C_SENSOR_ID;
+
+	sensorRegFile.ownAddress  = I2C_SENSOR_ADDRESS;
+	sensorRegFile.size        = I2C_SENSOR_REG_COUNT;
+	sensorRegFile.pBuffer[0]  = sensorRegBuffer0;
+	sensorRegFile.pBuffer[1]  = sensorRegBuffer1;
+
+	/*Configuración del canal I2C (la velocidad la impone el maestro)*/
+	i2cSlave.pI2Cx     = I2C1;
+	i2cSlave.i2c_mode  = eI2C_MODE_FM;
+
+	i2c_ConfigSlave(&i2cSlave, &sensorRegFile);
+}
+
+//Función para publicar la última medición. Si el maestro está leyendo, se publica en el siguiente ciclo
+void publishI2CSlave(void){
+
+	uint8_t *pRegs = i2c_SlaveGetWriteBuffer(&sensorRegFile);
+
+	if(pRegs == 0){
+		return;
+	}
+
+	sensorRegCounter++;
+
+	pRegs[SENSOR_REG_WHO_AM_I]    = I2C_SENSOR_ID;
+	pRegs[SENSOR_REG_COUNTER]     = sensorRegCounter;
+	pRegs[SENSOR_REG_RED_PCT]     = (uint8_t)aporteRedPorcentaje;
+	pRegs[SENSOR_REG_GREEN_PCT]   = (uint8_t)aporteGreenPorcentaje;
+	pRegs[SENSOR_REG_BLUE_PCT]    = (uint8_t)aporteBluePorcentaje;
+	pRegs[SENSOR_REG_NOTE_FREQ_L] = (uint8_t)(noteFrecValue & 0xFF);
+	pRegs[SENSOR_REG_NOTE_FREQ_H] = (uint8_t)(noteFrecValue >> 8);
+
+	i2c_SlavePublish(&sensorRegFile);
 }
 
 //Función para definir filtros de color a utilizar
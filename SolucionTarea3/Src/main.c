@@ -14,6 +14,7 @@
 #include "exti_driver_hal.h"
 #include "adc_driver_hal.h"
 #include "usart_driver_hal.h"
+#include "dsp_driver_hal.h"
 
 //Definimos pines a utilizar para verificación correcto funcionamiento
 GPIO_Handler_t verificationLed    = {0}; //PinA5 (Led para verificación de correcto funcionamiento)
@@ -122,8 +123,9 @@ uint8_t apagadoLed   = 1;
 uint8_t maskChangeDisplay     = 1;
 
 //Definimos variables para realizar promedio en conversiones ADC
-uint16_t valueProm = 0;
-uint16_t sumaProm = 0;
+//Promedio móvil de las últimas 8 conversiones (ventana potencia de 2)
+q15_t historialPromADC[8] = {0};
+DSP_MovingAverage_t filtroPromADC = {0};
 uint16_t counterTrimmerProm = 0;
 
 //Definimos variables para asignar el estado de la bandera correspondiente a cada interrupción
@@ -646,6 +648,14 @@ void initialConfig(){
 		adcFotoResistencia.interrupState       = ADC_INT_ENABLE;
 		adcFotoResistencia.samplingPeriod      = SAMPLING_PERIOD_144_CYCLES;
 
+		//Filtro para el promedio de las conversiones ADC (2^3 = 8 muestras)
+		dsp_MovingAverageInit(&filtroPromADC, historialPromADC, 3);
+
+		//Cargamos la configuración de ambos canales una sola vez, en cada lectura solo se cambia
+		//el canal de la secuencia. El trimmer queda como último para dejar activo su canal
+		ADCValueConfig(FotoResistencia);
+		ADCValueConfig(Trimmer);
+
 		//A continuación se está realizando configuración del puerto serial
 
 		/* Pin sobre los que funciona el USART2 (TX)*/
@@ -1184,35 +1194,19 @@ void counterEncoderAction(void){
 //Función para realizar promedios
 void promedio(uint16_t valueToProm){
 
-	//Definimos que vamos a promediar 5 valores de conversión
-	if(valueProm < 10){
-
-		//Acumulamos la suma de los valores a los cuales se les calculará el promedio
-		sumaProm += valueToProm;
-
-		//Aumentamos el valor de ValueProm para avanzar en la cantidad de datos a promediar
-		valueProm++;
-	} else{
-
-		//En caso de alcanzar los 10 datos se calcula el promedio
-		counterTrimmerProm = sumaProm / 10;
-
-		//Reiniciamos el valor de asignación del promedio y de la variable que permite acumular suma de datos a promediar
-		valueProm = 0;
-		sumaProm = 0;
+	//Actualizamos el promedio móvil con cada conversión (sin divisiones ni datos descartados)
+	counterTrimmerProm = (uint16_t)dsp_MovingAverage(&filtroPromADC, (q15_t)valueToProm);
 
-		//Generamos condicional en actualización de dato a representar en el display a la velocidad de 1 s aprox (relación con Timer)
-		//Verificamos si la bandera del timer está activada
-		if (banderaPromADC){
+	//Generamos condicional en actualización de dato a representar en el display a la velocidad de 1 s aprox (relación con Timer)
+	//Verificamos si la bandera del timer está activada
+	if (banderaPromADC){
 
-			//Bajamos la bandera
-			banderaPromADC = 0;
+		//Bajamos la bandera
+		banderaPromADC = 0;
 
-			//Definimos que el valor a representar en el display será el promedio de las conversiones ADC
-			counter_i = counterTrimmerProm;
-		}
+		//Definimos que el valor a representar en el display será el promedio de las conversiones ADC
+		counter_i = counterTrimmerProm;
 	}
-
 }
 
 //Función para configuración ADC
@@ -1267,14 +1261,8 @@ void ADCTrimmerAction(void){
 	    gpio_WritePin(&ledBlue, RESET);
 	    gpio_WritePin(&ledRed, RESET);
 
-	    //Llamamos a la función encargada del ADC en trimmer
-	    ADCValueConfig(Trimmer);
-
-	    //Se inicializa la conversión ADC
-	    adc_StartSingleConv();
-
-	    //Llamamos al valor de la conversión
-	    counterTrimmer = adc_Get_Value();
+	    //Convertimos el canal del trimmer y esperamos el dato de esta misma conversión
+	    adc_ReadChannel(adcTrimmer.channel, &counterTrimmer);
 
 	    //Cargamos valor promedio de conversión ADC en la variable a representar
 	    promedio(counterTrimmer);
@@ -1297,14 +1285,8 @@ void ADCFotoResistenciaAction(void){
 	    gpio_WritePin(&ledBlue, RESET);
 	    gpio_WritePin(&ledGreen, RESET);
 
-	    //Llamamos a la función encargada del ADC en foto resistencia
-	    ADCValueConfig(FotoResistencia);
-
-	    //Se inicializa la conversión ADC
-	    adc_StartSingleConv();
-
-	    //Cargamos valor de conversión ADC en la variable a representar
-	    counterFotoResistencia = adc_Get_Value();
+	    //Convertimos el canal de la foto resistencia y esperamos el dato de esta misma conversión
+	    adc_ReadChannel(adcFotoResistencia.channel, &counterFotoResistencia);
 
 	    //Cargamos valor promedio de conversión ADC en la variable a representar
 	    promedio(counterFotoResistencia);
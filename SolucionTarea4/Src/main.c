@@ -73,6 +73,11 @@ uint8_t bandera_Accel_PWM_Rx = 0;
 #define  BW_RATE             0x2C //Registro asociado al BAUD RATE
 #define  POWER_CTL           0x2D //Registro asociado al POWER SAVING FEATURES CONTROL
 
+//Registros de configuración del acelerómetro que se guardan en el caché del I2C
+//(los registros de datos son volátiles y siempre se leen del sensor)
+const uint8_t accelCachedRegs[] = {DATA_FORMAT, BW_RATE, POWER_CTL};
+I2C_RegCache_t accelRegCache = {0};
+
 /* Configuraciones iniciales para el acelerómetro */
 #define DATA_FORMAT_CONFIG   0b100   //Resolucion configurada en +- 2g, y también se activa justify
 #define BW_RATE_CONFIG       0x0A   //Data output rate a 100Hz --> Recomendación presentada en datasheet del accel.
@@ -241,6 +246,11 @@ void config_I2C(void){
 	//Cargamos la configuración del canal I2C
 	i2c_Config(&accelSensor);
 
+	//Caché de los registros de configuración: reescribir el mismo valor no usa el bus
+	accelRegCache.pRegMap  = accelCachedRegs;
+	accelRegCache.regCount = sizeof(accelCachedRegs);
+	i2c_AttachCache(&accelSensor, &accelRegCache);
+
 	/* Configuramos el timer de control de muestreo del acelerómetro*/
 	//The number of samples averaged is a choice of the system designer, but a
 	//recommended starting point is 0.1 sec worth of data for data --> En este dato por características descritas en condiciones de la tarea se usa 0.25s
@@ -406,22 +416,27 @@ void config_USART(void){
 //Función para obtener datos de aceleración en los tres ejes x.y,z
 void get_Accel(void){
 
-	//Se realiza la lectura de los resgistros correspondientes al eje X y sus valores High and Low
-	accelX_low  = i2c_ReadSingleRegister(&accelSensor, ACCEL_XOUT_L);
-	accelX_high = i2c_ReadSingleRegister(&accelSensor, ACCEL_XOUT_H);
+	//Se leen los 6 registros de datos (DATAX0 ... DATAZ1) en una sola transacción I2C.
+	//Así los tres ejes corresponden a la misma muestra del acelerómetro.
+	uint8_t accelData[6] = {0};
+
+	i2c_ReadManyRegisters(&accelSensor, ACCEL_XOUT_L, accelData, 6);
+
+	//Se cargan los valores High and Low del eje X
+	accelX_low  = accelData[0];
+	accelX_high = accelData[1];
 	//Asignamos en una variable el valor relacionado a la aceleración en el eje X
 	accelX = (accelX_high << 8) | accelX_low;
 
-
-	//Se realiza la lectura de los resgistros correspondientes al eje Y y sus valores High and Low
-	accelY_low  = i2c_ReadSingleRegister(&accelSensor, ACCEL_YOUT_L);
-	accelY_high = i2c_ReadSingleRegister(&accelSensor, ACCEL_YOUT_H);
+	//Se cargan los valores High and Low del eje Y
+	accelY_low  = accelData[2];
+	accelY_high = accelData[3];
 	//Asignamos en una variable el valor relacionado a la aceleración en el eje Y
 	accelY = (accelY_high << 8) | accelY_low;
 
-	//Se realiza la lectura de los resgistros correspondientes al eje Z y sus valores High and Low
-	accelZ_low  = i2c_ReadSingleRegister(&accelSensor, ACCEL_ZOUT_L);
-	accelZ_high = i2c_ReadSingleRegister(&accelSensor, ACCEL_ZOUT_H);
+	//Se cargan los valores High and Low del eje Z
+	accelZ_low  = accelData[4];
+	accelZ_high = accelData[5];
 	//Asignamos en una variable el valor relacionado a la aceleración en el eje Z
 	accelZ = (accelZ_high << 8) | accelZ_low;
 